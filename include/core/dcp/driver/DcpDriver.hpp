@@ -106,6 +106,18 @@ struct DcpDriver{
      * Disconnect all connections
      */
     std::function<void()> disconnect;
+    /**
+     * Sending several PDUs at once, e.g. all DAT_input_output PDUs of one step.
+     * Optional, if it is not set send is called for each PDU.
+     */
+    std::function<void(DcpPdu **, size_t)> sendBatch;
+    /**
+     * Memory of the transport protocol into which the DAT_input_output PDU of the given data id
+     * is serialized directly, length indicator included. The PDU is passed to send afterwards.
+     * Optional, if it is not set or returns nullptr the PDU is serialized into its own buffer.
+     * The second argument is the maximum number of bytes which will be written.
+     */
+    std::function<uint8_t *(dataId_t, size_t)> acquireOutput;
 };
 
 #endif //DCPLIB_DCPDRIVER_H
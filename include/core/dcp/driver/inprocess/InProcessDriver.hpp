@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_INPROCESSDRIVER_H
+#define DCPLIB_INPROCESSDRIVER_H
+
+#include <dcp/driver/DcpDriver.hpp>
+#include <dcp/driver/inprocess/InProcessNetwork.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <set>
+#include <vector>
+
+enum class InProcessMode : uint8_t {
+    /**
+     * send passes the PDU to receive of the target manager on the calling thread, nothing is copied.
+     * PDUs of concurrent senders reach the manager concurrently.
+     */
+    SYNCHRONOUS,
+    /**
+     * send copies the PDU into the mailbox of the target manager, which is processed in order by the thread
+     * calling startReceiving
+     */
+    MAILBOX
+};
+
+/**
+ * Driver for a master and slaves in one process. PDUs are routed through an InProcessNetwork by the
+ * network information of the UDP_IPv4 transport protocol, no socket is involved.
+ *
+ * Usage:
+ * InProcessNetwork network;
+ * InProcessDriver masterDriver(network, "127.0.0.1", 8000);
+ * InProcessDriver slaveDriver(network, "127.0.0.1", 8080);
+ * DcpManagerMaster master(masterDriver.getDcpDriver());
+ * DcpManagerSlave slave(slaveDescription, slaveDriver.getDcpDriver());
+ */
+class InProcessDriver {
+public:
+    /**
+     * @param network Network shared by all drivers of the process
+     * @param host Host of the control endpoint
+     * @param port Port of the control endpoint
+     * @param mode Delivery mode of PDUs addressed to this driver
+     */
+    InProcessDriver(InProcessNetwork &network, std::string host, uint16_t port,
+                    InProcessMode mode = InProcessMode::SYNCHRONOUS) : network(network), mode(mode) {
+        unsigned int b[4] = {0, 0, 0, 0};
+        std::sscanf(host.c_str(), "%u.%u.%u.%u", &b[0], &b[1], &b[2], &b[3]);
+        mainAddress = {(ip_address_t) ((b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3]), port};
+        lastAccess = {0, 0};
+        masterAddress = {0, 0};
+    }
+
+    ~InProcessDriver() {
+        closeConfiguredPorts();
+        network.unbind(mainAddress);
+        std::unique_lock<std::mutex> lock(mtxMailbox);
+        stopMailbox = true;
+        mailboxCV.notify_all();
+        mailboxCV.wait(lock, [this] { return !processingMailbox; });
+    }
+
+    DcpDriver getDcpDriver() {
+        return {[this](DcpPdu &msg) { this->send(msg); },
+                [this](dcpId_t dcpId, uint8_t *info) {
+                    otherSlaves[dcpId] = toAddress(info);
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    ioIn[dataId] = toAddress(info);
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    ioOut[dataId] = toAddress(info);
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    paramIn[paramId] = toAddress(info);
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    paramOut[paramId] = toAddress(info);
+                },
+                std::bind(&InProcessDriver::startReceiving, this),
+                [this](dcpId_t) {/*nothing to do for connectionless in-process delivery*/ },
+                [this](dcpId_t) {/*nothing to do for connectionless in-process delivery*/ },
+                [this](DcpManager manager) {
+                    this->dcpManager = manager;
+                },
+                [this](const LogManager &) {/*PDUs are not logged, to keep the harness free of noise*/ },
+                [this]() { masterAddress = lastAccess; },
+                std::bind(&InProcessDriver::openPorts, this),
+                [this]() {/*nothing to do for connectionless in-process delivery*/ },
+                std::bind(&InProcessDriver::closeConfiguredPorts, this),
+                [this]() {/*nothing to do for connectionless in-process delivery*/ },
+                //send is called for each PDU
+                nullptr,
+                //PDUs are serialized into their own buffer
+                nullptr,
+        };
+    }
+
+private:
+    struct Mail {
+        std::vector<uint8_t> stream;
+        InProcessAddress source;
+        bool control;
+    };
+
+    InProcessNetwork &network;
+    InProcessMode mode;
+    DcpManager dcpManager;
+
+    InProcessAddress mainAddress;
+    //Sender of the last PDU received on the control endpoint
+    InProcessAddress lastAccess;
+    InProcessAddress masterAddress;
+
+    std::map<dcpId_t, InProcessAddress> otherSlaves;
+    std::map<dataId_t, InProcessAddress> ioOut;
+    std::map<dataId_t, InProcessAddress> ioIn;
+    std::map<paramId_t, InProcessAddress> paramIn;
+    std::map<paramId_t, InProcessAddress> paramOut;
+    //Addresses bound by openPorts
+    std::set<InProcessAddress> boundPorts;
+
+    std::mutex mtxMailbox;
+    std::condition_variable mailboxCV;
+    std::deque<Mail> mailbox;
+    //Processed mails, their buffers are reused
+    std::vector<Mail> spareMails;
+    bool stopMailbox = false;
+    bool processingMailbox = false;
+
+    static InProcessAddress toAddress(uint8_t *info) {
+        return {*((ip_address_t *) (info + 2)), *((uint16_t *) info)};
+    }
+
+    void send(DcpPdu &msg) {
+        network.deliver(getAddress(msg), mainAddress, msg);
+    }
+
+    inline InProcessAddress getAddress(DcpPdu &msg) {
+        switch (msg.getTypeId()) {
+            case DcpPduType::DAT_input_output:
+                return ioOut[static_cast<DcpPduDatInputOutput &>(msg).getDataId()];
+            case DcpPduType::DAT_parameter:
+                return paramOut[static_cast<DcpPduDatParameter &>(msg).getParamId()];
+            case DcpPduType::NTF_state_changed:
+            case DcpPduType::NTF_log:
+                return masterAddress;
+            case DcpPduType::RSP_ack:
+            case DcpPduType::RSP_nack:
+            case DcpPduType::RSP_state_ack:
+            case DcpPduType::RSP_error_ack:
+            case DcpPduType::RSP_log_ack:
+                return lastAccess;
+            default:
+                return otherSlaves[static_cast<DcpPduBasic &>(msg).getReceiver()];
+        }
+    }
+
+    void receive(DcpPdu &msg, const InProcessAddress &source, bool control) {
+        if (mode == InProcessMode::SYNCHRONOUS) {
+            if (control) {
+                lastAccess = source;
+            }
+            //the receiver decodes its own copy, like a PDU read from a socket. Nested deliveries
+            //(a response sent while receiving) use the next buffer of this thread.
+            static thread_local std::vector<std::vector<uint8_t>> streams;
+            static thread_local size_t depth = 0;
+            if (streams.size() <= depth) {
+                streams.resize(depth + 1);
+            }
+            std::vector<uint8_t> &stream = streams[depth];
+            stream.assign(msg.serialize(), msg.serialize() + msg.getSerializedSize());
+            depth++;
+            {
+                DcpPduView pdu(stream.data(), stream.size() - PDU_LENGTH_INDICATOR_SIZE);
+                dcpManager.receive(*pdu);
+            }
+            depth--;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mtxMailbox);
+        Mail mail;
+        if (!spareMails.empty()) {
+            mail = std::move(spareMails.back());
+            spareMails.pop_back();
+        }
+        mail.stream.assign(msg.serialize(), msg.serialize() + msg.getSerializedSize());
+        mail.source = source;
+        mail.control = control;
+        mailbox.push_back(std::move(mail));
+        mailboxCV.notify_one();
+    }
+
+    InProcessNetwork::Endpoint endpoint(bool control) {
+        return [this, control](DcpPdu &msg, const InProcessAddress &source) { receive(msg, source, control); };
+    }
+
+    /**
+     * Bind the control endpoint. In MAILBOX mode the calling thread processes the mailbox until the
+     * driver is destroyed, in SYNCHRONOUS mode it returns immediately.
+     */
+    void startReceiving() {
+        network.bind(mainAddress, endpoint(true));
+        if (mode == InProcessMode::MAILBOX) {
+            processMailbox();
+        }
+    }
+
+    void processMailbox() {
+        std::unique_lock<std::mutex> lock(mtxMailbox);
+        processingMailbox = true;
+        while (!stopMailbox) {
+            if (mailbox.empty()) {
+                mailboxCV.wait(lock);
+                continue;
+            }
+            Mail mail = std::move(mailbox.front());
+            mailbox.pop_front();
+            lock.unlock();
+            if (mail.control) {
+                lastAccess = mail.source;
+            }
+            {
+                DcpPduView pdu(mail.stream.data(), mail.stream.size() - PDU_LENGTH_INDICATOR_SIZE);
+                dcpManager.receive(*pdu);
+            }
+            lock.lock();
+            spareMails.push_back(std::move(mail));
+        }
+        processingMailbox = false;
+        mailboxCV.notify_all();
+    }
+
+    void openPorts() {
+        for (auto &pos : ioIn) {
+            bindPort(pos.second);
+        }
+        for (auto &pos : paramIn) {
+            bindPort(pos.second);
+        }
+    }
+
+    void bindPort(const InProcessAddress &address) {
+        if (address == mainAddress || (mainAddress.ip == 0 && address.port == mainAddress.port) ||
+            boundPorts.count(address) > 0) {
+            return;
+        }
+        if (network.bind(address, endpoint(false))) {
+            boundPorts.insert(address);
+        } else {
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+        }
+    }
+
+    void closeConfiguredPorts() {
+        for (const InProcessAddress &address : boundPorts) {
+            network.unbind(address);
+        }
+        boundPorts.clear();
+        ioIn.clear();
+        paramIn.clear();
+    }
+};
+
+#endif //DCPLIB_INPROCESSDRIVER_H
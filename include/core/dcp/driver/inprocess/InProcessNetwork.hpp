@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_INPROCESSNETWORK_H
+#define DCPLIB_INPROCESSNETWORK_H
+
+#include <dcp/model/DcpTypes.hpp>
+#include <dcp/model/pdu/DcpPdu.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/**
+ * Address of an endpoint in an InProcessNetwork. Uses the format of the UDP_IPv4 network information,
+ * so the master configures in-process slaves like UDP slaves.
+ */
+struct InProcessAddress {
+    ip_address_t ip;
+    port_t port;
+
+    bool operator<(const InProcessAddress &other) const {
+        return ip < other.ip || (ip == other.ip && port < other.port);
+    }
+
+    bool operator==(const InProcessAddress &other) const {
+        return ip == other.ip && port == other.port;
+    }
+};
+
+/**
+ * Connects the InProcessDrivers of master and slaves in one address space.
+ * Endpoints are bound to addresses, a PDU sent to an address is passed to the bound endpoint.
+ */
+class InProcessNetwork {
+public:
+    typedef std::function<void(DcpPdu &, const InProcessAddress &)> Endpoint;
+
+    /**
+     * @param address Address to listen on, ip 0 (0.0.0.0) accepts PDUs for the port on every ip
+     * @param endpoint Receives the PDU and the address of its sender
+     * @return false if the address is already bound
+     */
+    bool bind(const InProcessAddress &address, Endpoint endpoint) {
+        std::lock_guard<std::mutex> lock(mtxEndpoints);
+        if (endpoints.count(address) > 0) {
+            return false;
+        }
+        endpoints[address] = std::make_shared<Endpoint>(std::move(endpoint));
+        return true;
+    }
+
+    void unbind(const InProcessAddress &address) {
+        std::lock_guard<std::mutex> lock(mtxEndpoints);
+        endpoints.erase(address);
+    }
+
+    /**
+     * Pass a PDU to the endpoint bound to target. The endpoint is called without holding any lock,
+     * so it may send PDUs itself.
+     * @return false if no endpoint is bound to target, the PDU is lost like a datagram without receiver
+     */
+    bool deliver(const InProcessAddress &target, const InProcessAddress &source, DcpPdu &pdu) {
+        std::shared_ptr<Endpoint> endpoint;
+        {
+            std::lock_guard<std::mutex> lock(mtxEndpoints);
+            auto it = endpoints.find(target);
+            if (it == endpoints.end()) {
+                it = endpoints.find({0, target.port});
+            }
+            if (it == endpoints.end()) {
+                return false;
+            }
+            endpoint = it->second;
+        }
+        (*endpoint)(pdu, source);
+        return true;
+    }
+
+private:
+    std::mutex mtxEndpoints;
+    std::map<InProcessAddress, std::shared_ptr<Endpoint>> endpoints;
+};
+
+#endif //DCPLIB_INPROCESSNETWORK_H
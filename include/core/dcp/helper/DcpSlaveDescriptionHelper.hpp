@@ -15,6 +15,8 @@
 #include <dcp/model/constant/DcpTransportProtocol.hpp>
 #include <dcp/helper/Helper.hpp>
 
+#include <unordered_map>
+
 namespace slavedescription {
 
     inline const Variable_t *getVariable(const SlaveDescription_t &slaveDescription, uint64_t vr) {
@@ -96,13 +98,7 @@ namespace slavedescription {
         return false;
     }
 
-    inline const DcpDataType getDataType(const SlaveDescription_t &slaveDescription, const uint64_t vr) {
-        const Variable_t *varP = getVariable(slaveDescription, vr);
-        if(varP == nullptr){
-            return DcpDataType::uint8;
-        }
-
-        const Variable_t &var = *varP;
+    inline const DcpDataType getDataType(const Variable_t &var) {
         if (var.Output.get() != nullptr) {
             const Output_t &output = *var.Output.get();
             if (output.Uint8.get() != nullptr) {
@@ -201,6 +197,110 @@ namespace slavedescription {
         return DcpDataType::uint8;
     }
 
+    inline const DcpDataType getDataType(const SlaveDescription_t &slaveDescription, const uint64_t vr) {
+        const Variable_t *varP = getVariable(slaveDescription, vr);
+        if(varP == nullptr){
+            return DcpDataType::uint8;
+        }
+        return getDataType(*varP);
+    }
+
+    /**
+     * Immutable index from value reference to variable and data type of a slave description.
+     * The index refers to the variables of the given slave description, which has to outlive it.
+     */
+    class SlaveDescriptionIndex {
+    public:
+        struct Entry {
+            const Variable_t *variable;
+            DcpDataType dataType;
+        };
+
+        explicit SlaveDescriptionIndex(const SlaveDescription_t &slaveDescription) {
+            variables.reserve(slaveDescription.Variables.size());
+            for (auto &var: slaveDescription.Variables) {
+                // the first variable with a value reference wins, as for the linear lookup
+                variables.insert(std::make_pair(var.valueReference, Entry{&var, getDataType(var)}));
+            }
+        }
+
+        inline const Entry *find(const uint64_t vr) const {
+            auto it = variables.find(vr);
+            if (it == variables.end()) {
+                return nullptr;
+            }
+            return &it->second;
+        }
+
+    private:
+        std::unordered_map<uint64_t, Entry> variables;
+    };
+
+    inline const Variable_t *getVariable(const SlaveDescriptionIndex &index, uint64_t vr) {
+        const SlaveDescriptionIndex::Entry *entry = index.find(vr);
+        if (entry != nullptr) {
+            return entry->variable;
+        }
+        return nullptr;
+    }
+
+    inline const CommonCausality_t *getInput(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        const Variable_t *variable = getVariable(index, vr);
+        if(variable != nullptr){
+            return variable->Input.get();
+        }
+        return nullptr;
+    }
+
+    inline const bool inputExists(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        return getInput(index, vr) != nullptr;
+    }
+
+    inline const Output_t *getOutput(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        const Variable_t *variable = getVariable(index, vr);
+        if(variable != nullptr){
+            return variable->Output.get();
+        }
+        return nullptr;
+    }
+
+    inline const bool outputExists(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        return getOutput(index, vr) != nullptr;
+    }
+
+    inline const CommonCausality_t *getParameter(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        const Variable_t *variable = getVariable(index, vr);
+        if(variable != nullptr){
+            return variable->Parameter.get();
+        }
+        return nullptr;
+    }
+
+    inline const bool parameterExists(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        return getParameter(index, vr) != nullptr;
+    }
+
+    inline const StructuralParameter_t *
+    getStructuralParameter(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        const Variable_t *variable = getVariable(index, vr);
+        if(variable != nullptr){
+            return variable->StructuralParameter.get();
+        }
+        return nullptr;
+    }
+
+    inline const bool structuralParameterExists(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        return getStructuralParameter(index, vr) != nullptr;
+    }
+
+    inline const DcpDataType getDataType(const SlaveDescriptionIndex &index, const uint64_t vr) {
+        const SlaveDescriptionIndex::Entry *entry = index.find(vr);
+        if (entry == nullptr) {
+            return DcpDataType::uint8;
+        }
+        return entry->dataType;
+    }
+
     inline const bool
     isTimeResolutionSupported(const SlaveDescription_t &slaveDescription, const uint32_t numerator,
                               const uint32_t denominator) {
@@ -11,9 +11,12 @@
 #define DCPLIB_LOGHELPER_HPP
 
 #include <typeinfo>
+#include <type_traits>
 #include <iomanip>
 #include <chrono>
 #include <algorithm>
+#include <memory>
+#include <iostream>
 
 #include <dcp/model/constant/DcpDataType.hpp>
 #include <dcp/model/constant/DcpPduType.hpp>
@@ -215,6 +218,62 @@ namespace DcpLogHelper {
         checkDataTypes(logTemplate, index + 1, args...);
     }
 
+    /**
+     * Compile time counterpart of getFixedSizeDcpDataType. Types without a DcpDataType match nothing.
+     */
+    template<typename T>
+    struct DataTypeOf {
+        static constexpr int value = -1;
+    };
+
+    template<DcpDataType Type>
+    struct KnownDataType {
+        static constexpr int value = (int) Type;
+    };
+
+    template<> struct DataTypeOf<uint8_t> : KnownDataType<DcpDataType::uint8> {};
+    template<> struct DataTypeOf<uint16_t> : KnownDataType<DcpDataType::uint16> {};
+    template<> struct DataTypeOf<uint32_t> : KnownDataType<DcpDataType::uint32> {};
+    template<> struct DataTypeOf<uint64_t> : KnownDataType<DcpDataType::uint64> {};
+    template<> struct DataTypeOf<int8_t> : KnownDataType<DcpDataType::int8> {};
+    template<> struct DataTypeOf<int16_t> : KnownDataType<DcpDataType::int16> {};
+    template<> struct DataTypeOf<int32_t> : KnownDataType<DcpDataType::int32> {};
+    template<> struct DataTypeOf<int64_t> : KnownDataType<DcpDataType::int64> {};
+    template<> struct DataTypeOf<float32_t> : KnownDataType<DcpDataType::float32> {};
+    template<> struct DataTypeOf<float64_t> : KnownDataType<DcpDataType::float64> {};
+    template<> struct DataTypeOf<std::string> : KnownDataType<DcpDataType::string> {};
+    template<> struct DataTypeOf<const char *> : KnownDataType<DcpDataType::string> {};
+    template<> struct DataTypeOf<DcpPduType> : KnownDataType<DcpDataType::pduType> {};
+    template<> struct DataTypeOf<DcpState> : KnownDataType<DcpDataType::state> {};
+    template<> struct DataTypeOf<DcpOpMode> : KnownDataType<DcpDataType::opMode> {};
+    template<> struct DataTypeOf<DcpDataType> : KnownDataType<DcpDataType::dataType> {};
+    template<> struct DataTypeOf<DcpError> : KnownDataType<DcpDataType::error> {};
+    template<> struct DataTypeOf<DcpScope> : KnownDataType<DcpDataType::scope> {};
+    template<> struct DataTypeOf<DcpTransportProtocol> : KnownDataType<DcpDataType::transportProtocol> {};
+    template<> struct DataTypeOf<DcpLogMode> : KnownDataType<DcpDataType::logMode> {};
+    template<> struct DataTypeOf<DcpLogLevel> : KnownDataType<DcpDataType::uint8> {};
+
+    template<DcpDataType... Types>
+    struct DataTypes {
+    };
+
+    /**
+     * True if the argument types match the data types of a LogDescriptor
+     */
+    template<typename Expected, typename ... Args>
+    struct ArgumentsMatch : std::false_type {
+    };
+
+    template<>
+    struct ArgumentsMatch<DataTypes<>> : std::true_type {
+    };
+
+    template<DcpDataType Type, DcpDataType... Types, typename Arg, typename ... Args>
+    struct ArgumentsMatch<DataTypes<Type, Types...>, Arg, Args...>
+            : std::integral_constant<bool, DataTypeOf<Arg>::value == (int) Type &&
+                                           ArgumentsMatch<DataTypes<Types...>, Args...>::value> {
+    };
+
 
 
 
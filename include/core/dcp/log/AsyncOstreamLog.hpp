@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_ASYNCOSTREAMLOG_H
+#define DCPLIB_ASYNCOSTREAMLOG_H
+
+#include <dcp/helper/Helper.hpp>
+#include <dcp/helper/LogHelper.hpp>
+#include <dcp/model/LogEntry.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Writes log entries to a stream on a background thread. logOstream only copies the entry into a bounded queue,
+ * the writer formats the queued entries in batches and flushes the stream once per batch.
+ * Entries are dropped if the queue is full.
+ */
+class AsyncOstreamLog {
+public:
+
+    /**
+     * @param _stream Stream to write to, must outlive this log
+     * @param capacity Maximum number of queued entries
+     * @param flushInterval Time after which queued entries are written at the latest
+     * @param batchSize Number of queued entries which wake up the writer before the flush interval elapsed
+     */
+    AsyncOstreamLog(std::ostream &_stream, size_t capacity = 4096,
+                    std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100),
+                    size_t batchSize = 256) :
+            stream(_stream), capacity(capacity), flushInterval(flushInterval), batchSize(batchSize),
+            queued(capacity), writing(capacity) {
+        writer = std::thread(&AsyncOstreamLog::run, this);
+    }
+
+    virtual ~AsyncOstreamLog() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        if (writer.joinable()) {
+            writer.join();
+        }
+    }
+
+    AsyncOstreamLog(const AsyncOstreamLog &) = delete;
+
+    AsyncOstreamLog &operator=(const AsyncOstreamLog &) = delete;
+
+    inline void logOstream(const LogEntry &log) {
+        if (!accept(log)) {
+            return;
+        }
+        bool wakeUp;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (queuedCount == capacity) {
+                dropped++;
+                return;
+            }
+            Entry &entry = queued[queuedCount++];
+            entry.time = log.getTime();
+            entry.level = log.getLevel();
+            entry.msg.assign(log.getMsg());
+            wakeUp = queuedCount == batchSize;
+        }
+        if (wakeUp) {
+            cv.notify_one();
+        }
+    }
+
+    /**
+     * Write all queued entries and flush the stream before returning.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const uint64_t requested = ++flushRequested;
+        cv.notify_one();
+        flushed.wait(lock, [this, requested] { return flushDone >= requested || stopped; });
+    }
+
+    uint64_t getDropped() const {
+        return dropped.load();
+    }
+
+protected:
+    /**
+     * Called for every entry before it is queued.
+     * @return false if the entry should not be written
+     */
+    virtual bool accept(const LogEntry &log) {
+        return true;
+    }
+
+private:
+    struct Entry {
+        int64_t time;
+        DcpLogLevel level;
+        std::string msg;
+    };
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait_for(lock, flushInterval, [this] {
+                return stopping || queuedCount >= batchSize || flushRequested > flushDone;
+            });
+            const uint64_t requested = flushRequested;
+            const bool stop = stopping;
+            //swap the queue, producers continue while the batch is written
+            std::swap(queued, writing);
+            size_t count = queuedCount;
+            queuedCount = 0;
+            lock.unlock();
+
+            for (size_t i = 0; i < count; i++) {
+                stream << convertUnixTimestamp(writing[i].time) << " \t "
+                       << to_string(writing[i].level) << " \t\t "
+                       << writing[i].msg << '\n';
+            }
+            if (count > 0 || requested > flushDone) {
+                stream.flush();
+            }
+
+            lock.lock();
+            flushDone = requested;
+            flushed.notify_all();
+            if (stop && queuedCount == 0) {
+                stopped = true;
+                flushed.notify_all();
+                return;
+            }
+        }
+    }
+
+    std::ostream &stream;
+    const size_t capacity;
+    const std::chrono::milliseconds flushInterval;
+    const size_t batchSize;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable flushed;
+    //entries are reused, so their strings keep the capacity of earlier messages
+    std::vector<Entry> queued;
+    std::vector<Entry> writing;
+    size_t queuedCount = 0;
+    uint64_t flushRequested = 0;
+    uint64_t flushDone = 0;
+    bool stopping = false;
+    bool stopped = false;
+    std::atomic<uint64_t> dropped{0};
+
+    std::thread writer;
+};
+
+#endif //DCPLIB_ASYNCOSTREAMLOG_H
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_BINARYFILELOG_H
+#define DCPLIB_BINARYFILELOG_H
+
+#include <dcp/log/BinaryLogFormat.hpp>
+#include <dcp/model/LogEntry.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * Appends the serialized log entries to memory mapped files. Logging an entry is a copy of its payload,
+ * messages are rendered later with BinaryLogReader (see src/tools/DcpLogDecoder.cpp).
+ * If a file is full, the next one is started and files older than the last maxFiles are deleted.
+ * Files are named <path>.<index>.dcplog with a zero padded index. POSIX only.
+ */
+class BinaryFileLog {
+public:
+
+    /**
+     * @param path Path prefix of the files
+     * @param fileSize Size of each file in bytes
+     * @param maxFiles Number of files which are kept, 0 keeps all
+     */
+    BinaryFileLog(const std::string &path, size_t fileSize = 64 * 1024 * 1024, size_t maxFiles = 4) :
+            path(path), fileSize(fileSize), maxFiles(maxFiles) {
+        openFile();
+    }
+
+    ~BinaryFileLog() {
+        closeFile();
+    }
+
+    BinaryFileLog(const BinaryFileLog &) = delete;
+
+    BinaryFileLog &operator=(const BinaryFileLog &) = delete;
+
+    void logBinary(const LogEntry &log) {
+        const LogTemplate &logTemplate = log.getLogTemplate();
+        const size_t templateSize = 7 + logTemplate.dataTypes.size() + logTemplate.msg.size();
+        const size_t entrySize = 5 + log.serializedSize();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        const bool defined = templates[logTemplate.id] == &logTemplate;
+        const size_t needed = entrySize + (defined ? 0 : templateSize) + 1;
+        if (sizeof(BinaryLogFormat::MAGIC) + templateSize + entrySize + 1 > fileSize) {
+            dropped++;
+            return;
+        }
+        if (position + needed > fileSize) {
+            closeFile();
+            fileIndex++;
+            openFile();
+        }
+        if (templates[logTemplate.id] != &logTemplate) {
+            writeTemplate(logTemplate);
+        }
+        memory[position] = BinaryLogFormat::ENTRY;
+        const uint32_t size = (uint32_t) log.serializedSize();
+        std::memcpy(memory + position + 1, &size, 4);
+        std::memcpy(memory + position + 5, log.serialize(), size);
+        position += entrySize;
+    }
+
+    /**
+     * Write the mapped pages of the current file back to disk.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        msync(memory, fileSize, MS_SYNC);
+    }
+
+    /**
+     * @return Number of entries which did not fit into an empty file
+     */
+    uint64_t getDropped() const {
+        return dropped;
+    }
+
+private:
+
+    void writeTemplate(const LogTemplate &logTemplate) {
+        uint8_t *record = memory + position;
+        record[0] = BinaryLogFormat::TEMPLATE;
+        record[1] = logTemplate.id;
+        record[2] = logTemplate.category;
+        record[3] = (uint8_t) logTemplate.level;
+        record[4] = (uint8_t) logTemplate.dataTypes.size();
+        size_t offset = 5;
+        for (DcpDataType type : logTemplate.dataTypes) {
+            record[offset++] = (uint8_t) type;
+        }
+        const uint16_t length = (uint16_t) logTemplate.msg.size();
+        std::memcpy(record + offset, &length, 2);
+        std::memcpy(record + offset + 2, logTemplate.msg.data(), length);
+        position += offset + 2 + length;
+        templates[logTemplate.id] = &logTemplate;
+    }
+
+    std::string fileName(size_t index) const {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), ".%06zu.dcplog", index);
+        return path + suffix;
+    }
+
+    void openFile() {
+        const std::string name = fileName(fileIndex);
+        fd = open(name.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::system_category(), "open " + name);
+        }
+        if (ftruncate(fd, fileSize) < 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "ftruncate " + name);
+        }
+        void *mapped = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "mmap " + name);
+        }
+        memory = (uint8_t *) mapped;
+        std::memcpy(memory, BinaryLogFormat::MAGIC, sizeof(BinaryLogFormat::MAGIC));
+        position = sizeof(BinaryLogFormat::MAGIC);
+        for (auto &logTemplate : templates) {
+            logTemplate = nullptr;
+        }
+        if (maxFiles > 0 && fileIndex >= maxFiles) {
+            unlink(fileName(fileIndex - maxFiles).c_str());
+        }
+    }
+
+    void closeFile() {
+        if (memory == nullptr) {
+            return;
+        }
+        munmap(memory, fileSize);
+        memory = nullptr;
+        //the byte after the last record is zero and marks the end, if truncating fails the zeroed rest is kept
+        int truncated = ftruncate(fd, position + 1);
+        (void) truncated;
+        close(fd);
+    }
+
+    const std::string path;
+    const size_t fileSize;
+    const size_t maxFiles;
+
+    std::mutex mutex;
+    int fd = -1;
+    uint8_t *memory = nullptr;
+    size_t position = 0;
+    size_t fileIndex = 0;
+    //templates defined in the current file, by id
+    const LogTemplate *templates[256] = {};
+    std::atomic<uint64_t> dropped{0};
+};
+
+#endif //DCPLIB_BINARYFILELOG_H
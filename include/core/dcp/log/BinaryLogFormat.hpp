@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_BINARYLOGFORMAT_H
+#define DCPLIB_BINARYLOGFORMAT_H
+
+#include <cstdint>
+
+/**
+ * Layout of the files written by BinaryFileLog. A file starts with the magic, followed by records.
+ * Every record starts with its kind, a zero kind marks the end of the file.
+ * TEMPLATE: id, category, level, data type count (uint8_t each), data types, message length (uint16_t), message
+ * ENTRY: payload size (uint32_t), payload as returned by LogEntry::serialize()
+ * Each file defines the templates it uses before their first entry, so it can be decoded on its own.
+ */
+namespace BinaryLogFormat {
+    static const char MAGIC[8] = {'D', 'C', 'P', 'L', 'O', 'G', 0, 1};
+
+    enum RecordKind : uint8_t {
+        END = 0,
+        TEMPLATE = 1,
+        ENTRY = 2,
+    };
+}
+
+#endif //DCPLIB_BINARYLOGFORMAT_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_BINARYLOGREADER_H
+#define DCPLIB_BINARYLOGREADER_H
+
+#include <dcp/log/BinaryLogFormat.hpp>
+#include <dcp/model/LogEntry.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Reads files written by BinaryFileLog and passes every entry with its generated message to a callback.
+ */
+class BinaryLogReader {
+public:
+
+    /**
+     * @param fileName File to read
+     * @param callback Called for every entry, the entry is only valid during the call
+     */
+    void read(const std::string &fileName, const std::function<void(LogEntry &)> &callback) {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file) {
+            throw std::invalid_argument("Can not open " + fileName);
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() < sizeof(BinaryLogFormat::MAGIC) ||
+            std::memcmp(data.data(), BinaryLogFormat::MAGIC, sizeof(BinaryLogFormat::MAGIC)) != 0) {
+            throw std::invalid_argument(fileName + " is no DCP binary log");
+        }
+
+        size_t position = sizeof(BinaryLogFormat::MAGIC);
+        while (position < data.size() && data[position] != BinaryLogFormat::END) {
+            const uint8_t *record = data.data() + position;
+            const size_t remaining = data.size() - position;
+            if (record[0] == BinaryLogFormat::TEMPLATE) {
+                if (remaining < 5 || remaining < 7 + (size_t) record[4]) {
+                    throw std::invalid_argument(fileName + " is truncated");
+                }
+                std::vector<DcpDataType> dataTypes;
+                for (size_t i = 0; i < record[4]; i++) {
+                    dataTypes.push_back((DcpDataType) record[5 + i]);
+                }
+                size_t offset = 5 + record[4];
+                uint16_t length;
+                std::memcpy(&length, record + offset, 2);
+                if (remaining < offset + 2 + length) {
+                    throw std::invalid_argument(fileName + " is truncated");
+                }
+                templates[record[1]].reset(new LogTemplate(record[1], record[2], (DcpLogLevel) record[3],
+                                                           std::string((const char *) record + offset + 2, length),
+                                                           dataTypes));
+                position += offset + 2 + length;
+            } else if (record[0] == BinaryLogFormat::ENTRY) {
+                if (remaining < 5) {
+                    throw std::invalid_argument(fileName + " is truncated");
+                }
+                uint32_t size;
+                std::memcpy(&size, record + 1, 4);
+                if (remaining < 5 + (size_t) size) {
+                    throw std::invalid_argument(fileName + " is truncated");
+                }
+                //at least time and id
+                if (size < 9 || templates[record[5 + 8]] == nullptr) {
+                    throw std::invalid_argument(fileName + " contains an entry without template");
+                }
+                //LogEntry works on a mutable payload
+                payload.assign(record + 5, record + 5 + size);
+                LogEntry entry(*templates[payload[8]], payload.data(), size);
+                entry.applyPayloadToString();
+                callback(entry);
+                position += 5 + size;
+            } else {
+                throw std::invalid_argument(fileName + " contains an unknown record kind " +
+                                            std::to_string(record[0]));
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<LogTemplate> templates[256];
+    std::vector<uint8_t> payload;
+};
+
+#endif //DCPLIB_BINARYLOGREADER_H
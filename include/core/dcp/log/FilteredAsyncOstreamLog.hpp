@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_FILTEREDASYNCOSTREAMLOG_H
+#define DCPLIB_FILTEREDASYNCOSTREAMLOG_H
+
+#include <dcp/log/AsyncOstreamLog.hpp>
+
+class FilteredAsyncOstreamLog : public AsyncOstreamLog {
+public:
+    FilteredAsyncOstreamLog(std::ostream &_stream, DcpLogLevel level, logCategory_t category,
+                            size_t capacity = 4096,
+                            std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100),
+                            size_t batchSize = 256) :
+            AsyncOstreamLog(_stream, capacity, flushInterval, batchSize), level(level), category(category) {}
+
+    ~FilteredAsyncOstreamLog() override {}
+
+protected:
+    bool accept(const LogEntry &log) override {
+        return log.getCategory() == category && log.getLevel() == level;
+    }
+
+private:
+    DcpLogLevel level;
+    logCategory_t category;
+};
+#endif //DCPLIB_FILTEREDASYNCOSTREAMLOG_H
@@ -14,6 +14,7 @@
 #include <map>
 
 #include <dcp/logic/DcpManager.hpp>
+#include <dcp/logic/SequenceTable.hpp>
 #include <dcp/driver/DcpDriver.hpp>
 #if defined(DEBUG) || defined(LOGGING)
 #include <dcp/logic/Logable.hpp>
@@ -42,9 +43,12 @@ public:
     }
 
     void start() {
-
+        started = true;
         driver.setDcpManager(getDcpManager());
 #if defined(DEBUG) || defined(LOGGING)
+        logRing.start([this](const LogTemplate &logTemplate, uint8_t *payload, size_t size) {
+            consume(logTemplate, payload, size);
+        });
         driver.setLogManager(logManager);
 #endif
         driver.startReceiving();
@@ -54,16 +58,43 @@ public:
 
     void addLogListener(std::function<void(const LogEntry &)> fct) {
         logListeners.push_back(std::move(fct));
+#if defined(DEBUG) || defined(LOGGING)
+        //listeners receive entries of every category and level
+        logFilter.enableAll();
+#endif
     }
 
     void setGenerateLogString(bool generateLogString) {
         this->generateLogString = generateLogString;
     }
 
+#if defined(DEBUG) || defined(LOGGING)
+    /**
+     * @return Number of log records dropped because the log ring was full or they were too large
+     */
+    size_t getDroppedLogRecords() const {
+        return logRing.getDropped();
+    }
+#endif
+
     virtual void reportError(const DcpError errorCode) = 0;
 
     virtual DcpManager getDcpManager() = 0;
 
+    /**
+     * @return Sequence state of the DAT_input_output PDUs received for a data id, nullptr if none was received
+     */
+    const SequenceTable::Entry *getInputOutputSequence(uint16_t dataId) const {
+        return dataSegNumsIn.find(dataId);
+    }
+
+    /**
+     * @return Sequence state of the DAT_parameter PDUs received for a param id, nullptr if none was received
+     */
+    const SequenceTable::Entry *getParameterSequence(uint16_t paramId) const {
+        return parameterSegNumsIn.find(paramId);
+    }
+
 protected:
     /**
      * DCP Driver instance
@@ -71,35 +102,43 @@ protected:
     DcpDriver driver;
 
     /**
-     * last seq. id which was send out
+     * next seq. id to send, by dcp id
      */
-    std::map<uint8_t, uint16_t> segNumsOut;
+    SequenceTable segNumsOut;
     /**
-     * last seq. id which was received
+     * last seq. id which was received, by dcp id
      */
-    std::map<uint8_t, uint16_t> segNumsIn;
+    SequenceTable segNumsIn;
 
     /**
-     * last seq. id which was send out
+     * next seq. id to send, by data id
      */
-    std::map<uint16_t, uint16_t> dataSegNumsOut;
+    SequenceTable dataSegNumsOut;
     /**
-     * last seq. id which was received
+     * last seq. id which was received, by data id
      */
-    std::map<uint16_t, uint16_t> dataSegNumsIn;
+    SequenceTable dataSegNumsIn;
 
-/**
-	 * last seq. id which was send out
-	 */
-    std::map<uint16_t, uint16_t> parameterSegNumsOut;
     /**
-     * last seq. id which was received
+     * next seq. id to send, by param id
+     */
+    SequenceTable parameterSegNumsOut;
+    /**
+     * last seq. id which was received, by param id
      */
-    std::map<uint16_t, uint16_t> parameterSegNumsIn;
+    SequenceTable parameterSegNumsIn;
 
 
     std::vector<std::function<void(const LogEntry &)>> logListeners;
     bool generateLogString;
+    //true once start() was called, the threading setup must not be changed afterwards
+    bool started = false;
+#if defined(DEBUG) || defined(LOGGING)
+    //Log records of this manager and its driver, consumed by a background thread after start()
+    LogRing logRing;
+    //Levels which are consumed, nothing is logged until a listener is added
+    LogFilter logFilter;
+#endif
 
     uint8_t dcpId;
     uint8_t masterId;
@@ -110,7 +149,7 @@ protected:
 #if defined(DEBUG) || defined(LOGGING)
         setLogManager({[this](const LogTemplate &logTemplate, uint8_t *payload, size_t size) {
             consume(logTemplate, payload, size);
-        }, [this](size_t size) { return alloc(size); }});
+        }, [this](size_t size) { return alloc(size); }, &logRing, &logFilter});
 #endif
     }
 
@@ -119,47 +158,29 @@ protected:
      * @param acuId acuId for which the seq. id. will be returned
      */
     uint16_t getNextSeqNum(const uint8_t acuId) {
-        int nextSeq = segNumsOut[acuId];
-        segNumsOut[acuId] += 1;
-        return nextSeq;
+        return segNumsOut.next(acuId);
     }
 
     uint16_t getNextDataSeqNum(const uint16_t data_id) {
-        int nextSeq = dataSegNumsOut[data_id];
-        dataSegNumsOut[data_id] += 1;
-        return nextSeq;
+        return dataSegNumsOut.next(data_id);
     }
 
     uint16_t checkSeqId(const uint8_t acuId, const uint16_t seqId) {
-        uint16_t old = segNumsIn[acuId];
-        if (seqId == old + 1) {
-            segNumsIn[acuId] = seqId;
-        }
-        return seqId - old;
+        return segNumsIn.checkNext(acuId, seqId);
     }
 
 
     uint16_t checkSeqIdInOut(const uint16_t dataId, const uint16_t seqId) {
-        uint16_t old = dataSegNumsIn[dataId];
-        if (seqId > old) {
-            dataSegNumsIn[dataId] = seqId;
-        }
-        return seqId - old;
+        return dataSegNumsIn.checkNewer(dataId, seqId);
     }
 
     uint16_t checkSeqIdParam(const uint16_t parameterId,
                              const uint16_t seqId) {
-        uint16_t old = parameterSegNumsIn[parameterId];
-        if (seqId > old) {
-            parameterSegNumsIn[parameterId] = seqId + 1;
-        }
-        return seqId - old;
+        return parameterSegNumsIn.checkNewer(parameterId, seqId);
     }
 
     uint16_t getNextParameterSeqNum(const uint16_t parameterId) {
-        int nextSeq = parameterSegNumsOut[parameterId];
-        parameterSegNumsOut[parameterId] += 1;
-        return nextSeq;
+        return parameterSegNumsOut.next(parameterId);
     }
 
 
@@ -171,8 +192,6 @@ protected:
         for (const std::function<void(const LogEntry &)> &logListener: logListeners) {
             logListener(logEntry);
         }
-        delete[] payload;
-
     }
 
     virtual uint8_t *alloc(size_t size) {
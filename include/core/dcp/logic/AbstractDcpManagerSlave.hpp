@@ -11,7 +11,9 @@
 #define ACI_LOGIC_DRIVERMANAGERSLAVE_H_
 
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <set>
 #include <iterator>
@@ -43,11 +45,15 @@
 #include <dcp/model/pdu/DcpPduStcRegister.hpp>
 #include <dcp/model/pdu/DcpPduStcRun.hpp>
 #include <dcp/model/MultiDimValue.hpp>
+#include <dcp/model/ValueArena.hpp>
 
 #include <dcp/helper/Helper.hpp>
 #include <dcp/helper/DcpSlaveDescriptionHelper.hpp>
 
 #include <dcp/logic/AbstractDcpManager.hpp>
+#include <dcp/logic/LogRequestBuffer.hpp>
+#include <dcp/logic/PduAdmission.hpp>
+#include <dcp/logic/StructureLock.hpp>
 #include <dcp/xml/DcpSlaveDescriptionElements.hpp>
 
 #if defined(DEBUG) || defined(LOGGING)
@@ -61,12 +67,6 @@
 #undef ERROR_LI
 #endif
 
-struct Payload {
-    uint8_t *payload;
-    size_t size;
-};
-
-
 /**
  * Basic Logic for a DCP slave
  *
@@ -77,15 +77,47 @@ public:
 
 
     ~AbstractDcpManagerSlave() {
+#if defined(DEBUG) || defined(LOGGING)
+        //consume uses the members of this class
+        logRing.stop();
+#endif
         for (auto const &entry : values) {
             delete entry.second;
         }
         for (auto const &entry : updatedStructure) {
             delete entry.second;
         }
+        delete valueArena;
+    }
+
+#if defined(DEBUG) || defined(LOGGING)
+    /**
+     * Set the buffer of log entries which wait for an INF_log of the master (DcpLogMode::LOG_ON_REQUEST).
+     * Buffered entries are discarded.
+     * @param capacity Bytes per log category
+     * @param policy Whether new or old entries are discarded if the buffer of a category is full
+     */
+    void setLogOnRequestBuffer(size_t capacity, LogRequestBuffer::Policy policy) {
+        logBuffer.configure(capacity, policy);
     }
 
-    void receive(DcpPdu &msg) override {
+    /**
+     * @return Number of log entries of the category discarded because its buffer was full
+     */
+    uint64_t getDroppedLogs(logCategory_t category) const {
+        return logBuffer.getDropped(category);
+    }
+#endif
+
+    void receive(DcpPdu &msg) final {
+        if (msg.getTypeId() == DcpPduType::DAT_input_output) {
+            //DAT_input_output PDUs of different sockets may be decoded concurrently
+            StructureLock::Shared lock(structureLock);
+            if (checkForError(msg)) {
+                decodeInputs(static_cast<DcpPduDatInputOutput &>(msg));
+            }
+            return;
+        }
 
         if (!checkForError(msg)) {
             return;
@@ -103,16 +135,9 @@ public:
             case DcpPduType::STC_configure: {
                 state = DcpState::CONFIGURING;
                 notifyStateChange();
-                for (auto const &ent : outputAssignment) {
-                    uint16_t dataId = ent.first;
-#ifdef DEBUG
-                    Log(DATA_BUFFER_CREATED, ent.first, bufferSize);
-#endif
-                    DcpPduDatInputOutput *pdu = new DcpPduDatInputOutput(0, ent.first, bufferSize);
-                    outputBuffer[ent.first] = pdu;
-
-
-                }
+                std::unique_lock<StructureLock> lock(structureLock);
+                clearOutputBuffer();
+                layoutValueArena();
 
                 std::map<uint32_t, std::vector<uint16_t>> stepsToDataId;
                 for (dataId_t dataId : runningScope) {
@@ -123,6 +148,19 @@ public:
                 for (auto &entry : stepsToDataId) {
                     outputCounter.push_back(std::make_tuple(entry.second, entry.first, entry.first));
                 }
+                //sequence ids of all configured PDUs get their entries now instead of on the first PDU
+                for (auto const &assignment : inputAssignment) {
+                    dataSegNumsIn.reserve(assignment.first);
+                }
+                for (auto const &assignment : outputAssignment) {
+                    dataSegNumsOut.reserve(assignment.first);
+                }
+                for (auto const &assignment : paramAssignment) {
+                    parameterSegNumsIn.reserve(assignment.first);
+                }
+                compileInputDecodePlan();
+                compileOutputSerializationPlan();
+                lock.unlock();
                 driver.configure();
                 configure();
                 break;
@@ -199,9 +237,9 @@ public:
                 DcpPduStcRegister registerPdu = static_cast<DcpPduStcRegister &>(msg);
                 setOperationInformation(registerPdu.getReceiver(), registerPdu.getOpMode());
                 seqAtRegister = registerPdu.getPduSeqId();
-                segNumsIn[masterId] = seqAtRegister;
+                segNumsIn[masterId].seqId = seqAtRegister;
 #ifdef DEBUG
-                Log(NEXT_SEQUENCE_ID_FROM_MASTER, (uint16_t) (segNumsIn[masterId] + 1));
+                Log(NEXT_SEQUENCE_ID_FROM_MASTER, (uint16_t) (segNumsIn[masterId].seqId + 1));
 #endif
                 driver.registerSuccessfull();
                 state = DcpState::CONFIGURATION;
@@ -220,17 +258,17 @@ public:
             }
             case DcpPduType::CFG_input: {
                 DcpPduCfgInput &inputConfig = static_cast<DcpPduCfgInput &>(msg);
+                std::lock_guard<StructureLock> lock(structureLock);
+                //DAT_input_output PDUs are checked against the sequence id from now on
+                dataSegNumsIn.reserve(inputConfig.getDataId());
                 configuredInPos[inputConfig.getDataId()].push_back(inputConfig.getPos());
                 inputAssignment[inputConfig.getDataId()][inputConfig.getPos()] = std::make_pair(
                         inputConfig.getTargetVr(),
                         inputConfig.getSourceDataType());
-                std::shared_ptr<uint32_t> maxConsecMissedPdus = slavedescription::getVariable(slaveDescription,
+                std::shared_ptr<uint32_t> maxConsecMissedPdus = slavedescription::getVariable(slaveDescriptionIndex,
                         inputConfig.getTargetVr())->maxConsecMissedPdus;
                 if(maxConsecMissedPdus != nullptr){
-                    if(maxConsecMissedPduData[inputConfig.getDataId()] == 0 ||
-                    *maxConsecMissedPdus < maxConsecMissedPduData[inputConfig.getDataId()]){
-                        maxConsecMissedPduData[inputConfig.getDataId()] = *maxConsecMissedPdus;
-                    }
+                    limitConsecMissedPdus(maxConsecMissedPduData, inputConfig.getDataId(), *maxConsecMissedPdus);
                 }
 
 
@@ -243,6 +281,7 @@ public:
 
             case DcpPduType::CFG_output: {
                 DcpPduCfgOutput &outputConfig = static_cast<DcpPduCfgOutput &>(msg);
+                std::lock_guard<StructureLock> lock(structureLock);
                 if (outputAssignment.find(outputConfig.getDataId()) == outputAssignment.end()) {
                     outputAssignment.insert(
                             std::make_pair(outputConfig.getDataId(),
@@ -263,9 +302,9 @@ public:
             }
             case DcpPduType::CFG_clear: {
                 clearConfig();
-                segNumsIn[masterId] = seqAtRegister;
+                segNumsIn[masterId].seqId = seqAtRegister;
 #ifdef DEBUG
-                Log(NEXT_SEQUENCE_ID_FROM_MASTER, (uint16_t) (segNumsIn[masterId] + 1));
+                Log(NEXT_SEQUENCE_ID_FROM_MASTER, (uint16_t) (segNumsIn[masterId].seqId + 1));
 #endif
                 break;
             }
@@ -284,26 +323,10 @@ public:
                 notifyStateChange();
                 break;
             }
-            case DcpPduType::DAT_input_output: {
-                DcpPduDatInputOutput &data = static_cast<DcpPduDatInputOutput &>(msg);
-                int offset = 0;
-                std::map<uint16_t, std::pair<uint64_t, DcpDataType>> vrsToReceive =
-                        inputAssignment[data.getDataId()];
-                for (uint16_t i = 0; i < vrsToReceive.size(); i++) {
-                    std::pair<uint64_t, DcpDataType> p = vrsToReceive[i];
-                    uint64_t valueReference = p.first;
-                    DcpDataType sourceDataType = p.second;
-
-                    offset += values[valueReference]->update(data.getPayload(), offset, sourceDataType);
-#ifdef DEBUG
-                    Log(ASSIGNED_INPUT, valueReference, sourceDataType,
-                        slavedescription::getDataType(slaveDescription, valueReference));
-#endif
-                }
-                break;
-            }
             case DcpPduType::DAT_parameter: {
                 DcpPduDatParameter &param = static_cast<DcpPduDatParameter &>(msg);
+                //a structural parameter rebuilds the decode and serialization plans
+                std::lock_guard<StructureLock> lock(structureLock);
 
                 int offset = 0;
                 std::map<uint16_t, std::pair<uint64_t, DcpDataType>> vrsToReceive =
@@ -313,11 +336,11 @@ public:
                     uint64_t valueReference = p.first;
                     DcpDataType sourceDataType = p.second;
 
-                    if (slavedescription::structuralParameterExists(slaveDescription, valueReference)) {
+                    if (slavedescription::structuralParameterExists(slaveDescriptionIndex, valueReference)) {
                         offset += values[valueReference]->update(param.getConfiguration(), offset, sourceDataType);
 
                         size_t value;
-                        switch (slavedescription::getDataType(slaveDescription, valueReference)) {
+                        switch (slavedescription::getDataType(slaveDescriptionIndex, valueReference)) {
                             case DcpDataType::uint8:
                                 value = *values[valueReference]->getValue<int8_t *>();
                                 break;
@@ -344,13 +367,14 @@ public:
             }
             case DcpPduType::CFG_parameter: {
                 DcpPduCfgParameter &parameter = static_cast<DcpPduCfgParameter &>(msg);
+                std::lock_guard<StructureLock> lock(structureLock);
                 uint64_t &valueReference = parameter.getParameterVr();
-                if (slavedescription::structuralParameterExists(slaveDescription, valueReference)) {
+                if (slavedescription::structuralParameterExists(slaveDescriptionIndex, valueReference)) {
                     values[valueReference]->update(parameter.getConfiguration(), 0,
-                                                   slavedescription::getDataType(slaveDescription, valueReference));
+                                                   slavedescription::getDataType(slaveDescriptionIndex, valueReference));
 
                     size_t value;
-                    switch (slavedescription::getDataType(slaveDescription, valueReference)) {
+                    switch (slavedescription::getDataType(slaveDescriptionIndex, valueReference)) {
                         case DcpDataType::uint8:
                             value = *values[valueReference]->getValue<int8_t *>();
                             break;
@@ -371,7 +395,7 @@ public:
                 } else {
                     checkForUpdatedStructure(parameter.getParameterVr());
                     values[valueReference]->update(parameter.getConfiguration(), 0,
-                                                   slavedescription::getDataType(slaveDescription, valueReference));
+                                                   slavedescription::getDataType(slaveDescriptionIndex, valueReference));
                 }
                 break;
             }
@@ -381,13 +405,10 @@ public:
                 paramAssignment[paramConfig.getParamId()][paramConfig.getPos()] = std::make_pair(
                         paramConfig.getParameterVr(),
                         paramConfig.getSourceDataType());
-                std::shared_ptr<uint32_t> maxConsecMissedPdus = slavedescription::getVariable(slaveDescription,
+                std::shared_ptr<uint32_t> maxConsecMissedPdus = slavedescription::getVariable(slaveDescriptionIndex,
                         paramConfig.getParameterVr())->maxConsecMissedPdus;
                 if(maxConsecMissedPdus != nullptr){
-                    if(maxConsecMissedPduData[paramConfig.getParamId()] == 0 ||
-                       *maxConsecMissedPdus <  maxConsecMissedPduData[paramConfig.getParamId()]){
-                        maxConsecMissedPduData[paramConfig.getParamId()] = *maxConsecMissedPdus;
-                    }
+                    limitConsecMissedPdus(maxConsecMissedPduParam, paramConfig.getParamId(), *maxConsecMissedPdus);
                 }
 #ifdef DEBUG
                 Log(NEW_TUNABLE_CONFIG, paramConfig.getParameterVr(), paramConfig.getSourceDataType(),
@@ -438,20 +459,10 @@ public:
             case DcpPduType::INF_log: {
 #if defined(DEBUG) || defined(LOGGING)
                 DcpPduInfLog &log = static_cast<DcpPduInfLog &>(msg);
-                size_t currentSize = 0;
-                uint8_t numLogs = 0;
 
                 DcpPduRspLogAck logAck = {dcpId, log.getPduSeqId(), logRspBuffer, bufferSize};
-                std::vector<Payload> &logs = logBuffer[log.getLogCategory()];
-                while (numLogs < log.getLogMaxNum() && logs.size() > 0 &&
-                       (logs.front().size + currentSize) < bufferSize) {
-                    const Payload &current = logs.front();
-                    memcpy(logAck.getPayload() + currentSize, current.payload, current.size);
-                    delete[] current.payload;
-                    logs.erase(logs.begin());
-                    currentSize += current.size;
-                    numLogs++;
-                }
+                size_t currentSize = logBuffer.pop(log.getLogCategory(), logAck.getPayload(), bufferSize,
+                                                   log.getLogMaxNum());
                 logAck.setPduSize(currentSize);
                 driver.send(logAck);
 #endif
@@ -463,19 +474,20 @@ public:
                 DcpPduCfgLogging &logging = static_cast<DcpPduCfgLogging &>(msg);
                 uint8_t categoryStart = 1;
                 uint8_t categoryEnd = 255;
-                std::map<logCategory_t, std::map<DcpLogLevel, bool>> &map = logOnRequest;
-                std::map<logCategory_t, std::map<DcpLogLevel, bool>> &notMap = logOnNotification;
+                LogFilter *mode = &logOnRequest;
+                LogFilter *otherMode = &logOnNotification;
                 if (logging.getLogCategory() != 0) {
                     categoryStart = logging.getLogCategory();
                     categoryEnd = logging.getLogCategory();
                 }
                 if (logging.getLogMode() == DcpLogMode::LOG_ON_NOTIFICATION) {
-                    map = logOnNotification;
-                    notMap = logOnRequest;
+                    mode = &logOnNotification;
+                    otherMode = &logOnRequest;
                 }
                 for (int i = categoryStart; i <= categoryEnd; i++) {
-                    map[i][logging.getLogLevel()] = true;
-                    notMap[i][logging.getLogLevel()] = false;
+                    mode->setEnabled(i, logging.getLogLevel(), true);
+                    otherMode->setEnabled(i, logging.getLogLevel(), false);
+                    logFilter.setEnabled(i, logging.getLogLevel(), true);
                 }
 #endif
                 break;
@@ -519,7 +531,8 @@ public:
     }
 
     /**
-     * Get a pointer to a input
+     * Get a pointer to a input. After STC_configure the pointer points into the value arena and stays valid until
+     * the next STC_configure or until a structural parameter changes the dimensions.
      * @tparam T Data type of the input. Has to be a pointer. E. g. uint16_t* for uint16.
      * @param vr Value reference of the input
      * @return Pointer to value of the corresponding input.
@@ -531,7 +544,8 @@ public:
     }
 
     /**
-     * Get a pointer to an output
+     * Get a pointer to an output. After STC_configure the pointer points into the value arena and stays valid until
+     * the next STC_configure or until a structural parameter changes the dimensions.
      * @tparam T Data type of the output. Has to be a pointer. E. g. uint16_t* for uint16.
      * @param vr Value reference of the output
      * @return Pointer to value of the corresponding output.
@@ -543,7 +557,8 @@ public:
     }
 
     /**
-     * Get a pointer to a parameter
+     * Get a pointer to a parameter. After STC_configure the pointer points into the value arena and stays valid until
+     * the next STC_configure or until a structural parameter changes the dimensions.
      * @tparam T Data type of the parameter. Has to be a pointer. E. g. uint16_t* for uint16.
      * @param vr Value reference of the parameter
      * @return Pointer to value of the corresponding parameter.
@@ -558,8 +573,9 @@ public:
 protected:
 
     const SlaveDescription_t slaveDescription;
+    //O(1) lookup of variables by value reference, refers to slaveDescription
+    const slavedescription::SlaveDescriptionIndex slaveDescriptionIndex;
 
-    std::map<DcpState, std::map<DcpPduType, bool>> stateChangePossible;
 
     uint16_t seqAtRegister;
 
@@ -582,25 +598,57 @@ protected:
 
 #if defined(DEBUG) || defined(LOGGING)
     /*Logging*/
-    std::map<logCategory_t, std::map<DcpLogLevel, bool>> logOnNotification;
-    std::map<logCategory_t, std::map<DcpLogLevel, bool>> logOnRequest;
+    //read by consume on the log thread, set by CFG_logging on the receiving thread
+    LogFilter logOnNotification;
+    LogFilter logOnRequest;
 
-    std::map<logCategory_t, std::vector<Payload>> logBuffer;
+    LogRequestBuffer logBuffer;
 
     uint8_t *logRspBuffer = new uint8_t[bufferSize];
 #endif
     /*Data Handling*/
     std::map<valueReference_t, MultiDimValue *> values;
+    //Payloads of all fixed size values, laid out at STC_configure
+    ValueArena *valueArena = nullptr;
 
     std::set<dataId_t> sourceNetworkConfigured;
     std::set<dataId_t> targetNetworkConfigured;
     std::set<paramId_t> paramNetworkConfigured;
 
     //Outputs
+    //largest payload of a DAT_input_output PDU, its size is stored in 16 bit
+    static const size_t MAX_OUTPUT_PAYLOAD_SIZE = 0xFFFF;
     std::map<dataId_t, DcpPduDatInputOutput *> outputBuffer;
+    //payload size each output buffer was created with
+    std::map<dataId_t, size_t> outputBufferCapacity;
     std::map<dataId_t, std::map<pos_t, valueReference_t>> outputAssignment;
     std::map<dataId_t, std::vector<pos_t>> configuredOutPos;
 
+    /**
+     * A fixed size run of output bytes which is copied with a single memcpy, or a variable size
+     * output (count > 0) which is serialized element by element.
+     */
+    struct OutputSerializationStep {
+        const uint8_t *source;
+        size_t length;
+        size_t count;
+        size_t baseSize;
+    };
+
+    struct OutputSerializationPlan {
+        DcpPduDatInputOutput *pdu;
+        size_t first;
+        size_t last;
+        //size of the output buffer, length indicator included
+        size_t capacity;
+    };
+    //Serialization steps of all data ids, ordered by data id and position
+    std::vector<OutputSerializationStep> outputSerializationSteps;
+    //Output buffer and [first, last) range in outputSerializationSteps, indexed by data id
+    std::vector<OutputSerializationPlan> outputSerializationPlan;
+    //PDUs of one sendOutputs call, which are passed to the driver at once
+    std::vector<DcpPdu *> outputBatch;
+
     std::vector<dataId_t> runningScope;
     std::vector<dataId_t> initializationScope;
 
@@ -613,13 +661,38 @@ protected:
     std::map<dataId_t, std::map<pos_t, std::pair<valueReference_t, DcpDataType>>> inputAssignment;
     std::map<dataId_t, std::vector<pos_t>> configuredInPos;
 
-    std::map<dataId_t, uint16_t> maxConsecMissedPduData;
+    //smallest maxConsecMissedPdus of the assigned inputs, indexed by data id, 0 if unlimited
+    std::vector<uint16_t> maxConsecMissedPduData;
+
+    /**
+     * One input of a DAT_input_output pdu, resolved at STC_configure.
+     */
+    struct InputDecodeStep {
+        uint8_t *destination;
+        DcpDataType sourceDataType;
+        DcpConverter converter;
+        size_t count;
+        size_t baseSize;
+#ifdef DEBUG
+        valueReference_t valueReference;
+        DcpDataType dataType;
+#endif
+    };
+    //Decode steps of all data ids, ordered by data id and position
+    std::vector<InputDecodeStep> inputDecodeSteps;
+    //[first, last) range in inputDecodeSteps, indexed by data id
+    std::vector<std::pair<size_t, size_t>> inputDecodePlan;
+    //Expected pdu size of DAT_input_output, indexed by data id, 0 if unknown or of variable size
+    std::vector<size_t> inputPduSize;
+    //Shared by decoding inputs and sending outputs, exclusive while the structures they read are changed
+    StructureLock structureLock;
 
     //Parameter
     std::map<paramId_t, std::vector<pos_t>> configuredParamPos;
     std::map<paramId_t, std::map<pos_t, std::pair<valueReference_t, DcpDataType>>> paramAssignment;
 
-    std::map<dataId_t, uint16_t> maxConsecMissedPduParam;
+    //smallest maxConsecMissedPdus of the assigned parameters, indexed by param id, 0 if unlimited
+    std::vector<uint16_t> maxConsecMissedPduParam;
 
 
     //which sttructual parameter (valueReference) change which inputs/outputs/parameters (valueReference)
@@ -634,7 +707,8 @@ protected:
 #endif
 
 
-    AbstractDcpManagerSlave(const SlaveDescription_t _slaveDescription) : slaveDescription(_slaveDescription) {
+    AbstractDcpManagerSlave(const SlaveDescription_t _slaveDescription) : slaveDescription(_slaveDescription),
+                                                                          slaveDescriptionIndex(slaveDescription) {
         this->errorCode = DcpError::NONE;
         this->state = DcpState::ALIVE;
         this->masterId = 0;
@@ -644,126 +718,6 @@ protected:
         this->numerator = 0;
         this->denominator = 0;
 
-        //define possible state changes
-        stateChangePossible[DcpState::ALIVE][DcpPduType::STC_register] = true;
-        stateChangePossible[DcpState::ALIVE][DcpPduType::INF_state] = true;
-
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::STC_deregister] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::STC_prepare] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_steps] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_time_res] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_input] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_output] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_clear] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_target_network_information] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_source_network_information] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_tunable_parameter] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_parameter] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_param_network_information] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_logging] = true;
-        stateChangePossible[DcpState::CONFIGURATION][DcpPduType::CFG_scope] = true;
-
-        stateChangePossible[DcpState::PREPARING][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::PREPARING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::PREPARING][DcpPduType::INF_log] = true;
-
-        stateChangePossible[DcpState::PREPARED][DcpPduType::STC_configure] = true;
-        stateChangePossible[DcpState::PREPARED][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::PREPARED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::PREPARED][DcpPduType::INF_log] = true;
-
-        stateChangePossible[DcpState::CONFIGURING][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::CONFIGURING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::CONFIGURING][DcpPduType::INF_log] = true;
-
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::STC_initialize] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::STC_run] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::CONFIGURED][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::INITIALIZING][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::INITIALIZING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::INITIALIZING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::INITIALIZING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::INITIALIZING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::STC_send_outputs] = true;
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::INITIALIZED][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::SENDING_I][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::SENDING_I][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::SENDING_I][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::SENDING_I][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::SENDING_I][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::STC_do_step] = true;
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::SYNCHRONIZING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::STC_run] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::STC_do_step] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::SYNCHRONIZED][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::RUNNING][DcpPduType::STC_do_step] = true;
-        stateChangePossible[DcpState::RUNNING][DcpPduType::STC_stop] = true;
-        stateChangePossible[DcpState::RUNNING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::RUNNING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::RUNNING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::RUNNING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::COMPUTING][DcpPduType::STC_send_outputs] = true;
-        stateChangePossible[DcpState::COMPUTING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::COMPUTING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::COMPUTING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::COMPUTING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::SENDING_D][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::SENDING_D][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::SENDING_D][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::SENDING_D][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::STOPPING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::STOPPING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::STOPPING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::STOPPING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::STOPPED][DcpPduType::STC_deregister] = true;
-        stateChangePossible[DcpState::STOPPED][DcpPduType::STC_reset] = true;
-        stateChangePossible[DcpState::STOPPED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::STOPPED][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::STOPPED][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::STOPPED][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::ERROR_HANDLING][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::ERROR_HANDLING][DcpPduType::INF_error] = true;
-        stateChangePossible[DcpState::ERROR_HANDLING][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::ERROR_HANDLING][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::ERROR_HANDLING][DcpPduType::DAT_parameter] = true;
-
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::STC_reset] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::STC_deregister] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::INF_state] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::INF_error] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::INF_log] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::DAT_input_output] = true;
-        stateChangePossible[DcpState::ERROR_RESOLVED][DcpPduType::DAT_parameter] = true;
-
         for (auto const &timeResolution : slaveDescription.TimeRes.resolutions) {
             if (timeResolution.fixed) {
                 numerator = timeResolution.numerator;
@@ -784,7 +738,7 @@ protected:
         for (auto const &var: slaveDescription.Variables) {
             if (var.StructuralParameter.get() != nullptr) {
                 const valueReference_t valueReference = var.valueReference;
-                const DcpDataType dataType = slavedescription::getDataType(slaveDescription, valueReference);
+                const DcpDataType dataType = slavedescription::getDataType(slaveDescriptionIndex, valueReference);
                 size_t baseSize = 0;
                 switch (dataType) {
                     case DcpDataType::binary:
@@ -844,7 +798,7 @@ protected:
 
         for (auto const &var: slaveDescription.Variables) {
             const valueReference_t &valueReference = var.valueReference;
-            const DcpDataType dataType = slavedescription::getDataType(slaveDescription, valueReference);
+            const DcpDataType dataType = slavedescription::getDataType(slaveDescriptionIndex, valueReference);
             size_t baseSize = 0;
             switch (dataType) {
                 case DcpDataType::binary:
@@ -1368,11 +1322,31 @@ protected:
     }
 
     void nack(uint16_t respSeqId, DcpError errorCode) {
-        const uint16_t expSeqId = segNumsIn[masterId] + 1;
+        const uint16_t expSeqId = segNumsIn[masterId].seqId + 1;
         DcpPduRspNack nack = {DcpPduType::RSP_nack, dcpId, respSeqId, expSeqId, errorCode};
         driver.send(nack);
     }
 
+    static void limitConsecMissedPdus(std::vector<uint16_t> &limits, uint16_t id, uint32_t maxConsecMissedPdus) {
+        if (id >= limits.size()) {
+            limits.resize(id + 1, 0);
+        }
+        if (limits[id] == 0 || maxConsecMissedPdus < limits[id]) {
+            limits[id] = maxConsecMissedPdus;
+        }
+    }
+
+    /**
+     * @return Size of a DAT_input_output PDU of the data id, 0 if it is not known without the payload
+     */
+    inline size_t expectedInputPduSize(uint16_t dataId) const {
+        return dataId < inputPduSize.size() ? inputPduSize[dataId] : 0;
+    }
+
+    static inline bool exceedsConsecMissedPdus(const std::vector<uint16_t> &limits, uint16_t id, uint16_t diff) {
+        return id < limits.size() && limits[id] > 0 && limits[id] < diff;
+    }
+
     bool checkForError(DcpPdu &msg) {
         bool valid = true;
         DcpError error = DcpError::NONE;
@@ -1398,7 +1372,8 @@ protected:
             case DcpPduType::DAT_input_output: {
                 //toDo distinguish scopes
                 DcpPduDatInputOutput &aciPduData = static_cast<DcpPduDatInputOutput &>(msg);
-                if (inputAssignment.count(aciPduData.getDataId()) == 0) {
+                if (expectedInputPduSize(aciPduData.getDataId()) == 0 &&
+                    inputAssignment.count(aciPduData.getDataId()) == 0) {
 #if defined(DEBUG) || defined(LOGGING)
                     Log(UNKNOWN_DATA_ID, aciPduData.getDataId());
 #endif
@@ -1438,7 +1413,7 @@ protected:
                     notifyMissingInputOutputPduListener(dcpPduDatInputOutput.getDataId());
                     Log(IN_OUT_PDU_MISSED);
                 }
-                if(maxConsecMissedPduData[dcpPduDatInputOutput.getDataId()] > 0 && maxConsecMissedPduData[dcpPduDatInputOutput.getDataId()] < diff){
+                if (exceedsConsecMissedPdus(maxConsecMissedPduData, dcpPduDatInputOutput.getDataId(), diff)) {
                     gotoErrorHandling();
                     gotoErrorResolved();
                     return false;
@@ -1453,7 +1428,7 @@ protected:
                     notifyMissingParameterPduListener(dcpPduDatParameter.getParamId());
                     Log(PARAM_PDU_MISSED);
                 }
-                if(maxConsecMissedPduParam[dcpPduDatParameter.getParamId()] > 0 && maxConsecMissedPduParam[dcpPduDatParameter.getParamId()] < diff){
+                if (exceedsConsecMissedPdus(maxConsecMissedPduParam, dcpPduDatParameter.getParamId(), diff)) {
                     gotoErrorHandling();
                     gotoErrorResolved();
                     return false;
@@ -1507,20 +1482,28 @@ protected:
             switch (msg.getTypeId()) {
                 case DcpPduType::DAT_input_output: {
                     DcpPduDatInputOutput &aciPduData = static_cast<DcpPduDatInputOutput &>(msg);
-                    size_t correctLength = 0;
-                    for (auto &pos: inputAssignment[aciPduData.getDataId()]) {
-                        switch (pos.second.second) {
-                            case DcpDataType::binary:
-                            case DcpDataType::string:
-                                correctLength += *((uint16_t *) (aciPduData.getPayload() + correctLength));
-                                break;
-                            default:
-                                correctLength += getDcpDataTypeSize(pos.second.second);
+                    size_t correctLength = expectedInputPduSize(aciPduData.getDataId());
+                    if (correctLength == 0) {
+                        const size_t payloadSize = aciPduData.getPduSize() - 5;
+                        for (auto &pos: inputAssignment.at(aciPduData.getDataId())) {
+                            const size_t count = values[pos.second.first]->getNumberOfAssignments();
+                            switch (pos.second.second) {
+                                case DcpDataType::binary:
+                                case DcpDataType::string:
+                                    //every element is prefixed with its uint32 length
+                                    for (size_t i = 0; i < count && correctLength + 4 <= payloadSize; i++) {
+                                        correctLength += 4 + *((uint32_t *) (aciPduData.getPayload() + correctLength));
+                                    }
+                                    break;
+                                default:
+                                    correctLength += getDcpDataTypeSize(pos.second.second) * count;
+                            }
                         }
+                        correctLength += 5;
                     }
-                    if (aciPduData.getPduSize() != (correctLength + 5)) {
+                    if (aciPduData.getPduSize() != correctLength) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_LENGTH, (uint16_t) aciPduData.getPduSize(), (uint16_t) (correctLength + 5));
+                        Log(INVALID_LENGTH, (uint16_t) aciPduData.getPduSize(), (uint16_t) correctLength);
 #endif
                         return false;
 
@@ -1530,14 +1513,19 @@ protected:
                 case DcpPduType::DAT_parameter: {
                     DcpPduDatParameter &aciPduParam = static_cast<DcpPduDatParameter &>(msg);
                     size_t correctLength = 0;
+                    const size_t configurationSize = aciPduParam.getPduSize() - 5;
                     for (auto &pos: paramAssignment[aciPduParam.getParamId()]) {
+                        const size_t count = values[pos.second.first]->getNumberOfAssignments();
                         switch (pos.second.second) {
                             case DcpDataType::binary:
                             case DcpDataType::string:
-                                correctLength += *((uint16_t *) (aciPduParam.getConfiguration()));
+                                //every element is prefixed with its uint32 length
+                                for (size_t i = 0; i < count && correctLength + 4 <= configurationSize; i++) {
+                                    correctLength += 4 + *((uint32_t *) (aciPduParam.getConfiguration() + correctLength));
+                                }
                                 break;
                             default:
-                                correctLength += getDcpDataTypeSize(pos.second.second);
+                                correctLength += getDcpDataTypeSize(pos.second.second) * count;
                                 break;
                         }
                     }
@@ -1588,7 +1576,7 @@ protected:
             switch (msg.getTypeId()) {
                 case DcpPduType::DAT_input_output:
                 case DcpPduType::DAT_parameter: {
-                    if (!stateChangePossible[state][msg.getTypeId()]) {
+                    if (!PduAdmission::isAllowed(state, msg.getTypeId())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(DATA_NOT_ALLOWED, state);
 #endif
@@ -1599,7 +1587,7 @@ protected:
                     break;
                 }
                 default:
-                    if (!stateChangePossible[state][msg.getTypeId()]) {
+                    if (!PduAdmission::isAllowed(state, msg.getTypeId())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(MSG_NOT_ALLOWED, msg.getTypeId(), state);
 #endif
@@ -1809,6 +1797,18 @@ protected:
                         }
                     }
 
+                    for (auto &entr : outputAssignment) {
+                        const size_t fixedSize = getFixedOutputSize(entr.second);
+                        if (fixedSize > MAX_OUTPUT_PAYLOAD_SIZE) {
+#if defined(DEBUG) || defined(LOGGING)
+                            Log(OUTPUT_PDU_TOO_LARGE, entr.first, (uint64_t) fixedSize);
+#endif
+                            if (error == DcpError::NONE) {
+                                error = DcpError::NOT_SUPPORTED_PDU_SIZE;
+                            }
+                        }
+                    }
+
                     if (!timeResolutionSet) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INCOMPLETE_CONFIGURATION_TIME_RESOLUTION);
@@ -1939,11 +1939,11 @@ protected:
 
                             const uint64_t vr = e.second;
 
-                            const Output_t &output = *slavedescription::getOutput(slaveDescription, vr);
+                            const Output_t &output = *slavedescription::getOutput(slaveDescriptionIndex, vr);
 
                             if (!slavedescription::isStepsSupported(slaveDescription, output, setSteps.getSteps())) {
 #if defined(DEBUG) || defined(LOGGING)
-                                Log(INVALID_STEPS, setSteps.getSteps(), vr, output.fixedSteps ?
+                                Log(INVALID_STEPS, setSteps.getSteps(), output.fixedSteps ?
                                                                             std::to_string(
                                                                                     output.defaultSteps)
                                                                                               :
@@ -1966,18 +1966,18 @@ protected:
                 }
                 case DcpPduType::CFG_input: {
                     DcpPduCfgInput &configInput = static_cast<DcpPduCfgInput &>(msg);
-                    if (!slavedescription::inputExists(slaveDescription, configInput.getTargetVr())) {
+                    if (!slavedescription::inputExists(slaveDescriptionIndex, configInput.getTargetVr())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_VALUE_REFERENCE_INPUT, configInput.getTargetVr());
 #endif
                         error = DcpError::INVALID_VALUE_REFERENCE;
                         break;
                     }
-                    if (!castAllowed(slavedescription::getDataType(slaveDescription, configInput.getTargetVr()),
+                    if (!castAllowed(slavedescription::getDataType(slaveDescriptionIndex, configInput.getTargetVr()),
                                      configInput.getSourceDataType())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_SOURCE_DATA_TYPE, configInput.getSourceDataType(),
-                            slavedescription::getDataType(slaveDescription,
+                            slavedescription::getDataType(slaveDescriptionIndex,
                                                           configInput.getTargetVr()));
 #endif
                         if (error == DcpError::NONE) {
@@ -1989,21 +1989,20 @@ protected:
                 }
                 case DcpPduType::CFG_output: {
                     DcpPduCfgOutput &outputConfig = static_cast<DcpPduCfgOutput &>(msg);
-                    if (!slavedescription::outputExists(slaveDescription, outputConfig.getSourceVr())) {
+                    if (!slavedescription::outputExists(slaveDescriptionIndex, outputConfig.getSourceVr())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_VALUE_REFERENCE_OUTPUT, outputConfig.getSourceVr());
 #endif
                         error = DcpError::INVALID_VALUE_REFERENCE;
                         break;
                     }
-                    const Output_t &output = *slavedescription::getOutput(slaveDescription, outputConfig.getSourceVr());
+                    const Output_t &output = *slavedescription::getOutput(slaveDescriptionIndex, outputConfig.getSourceVr());
                     if (steps.count(outputConfig.getDataId()) >= 1) {
 
                         if (!slavedescription::isStepsSupported(slaveDescription, output,
                                                                 steps[outputConfig.getDataId()])) {
 #if defined(DEBUG) || defined(LOGGING)
-                            Log(INVALID_STEPS, steps[outputConfig.getDataId()],
-                                outputConfig.getSourceVr(), output.fixedSteps ?
+                            Log(INVALID_STEPS, steps[outputConfig.getDataId()], output.fixedSteps ?
                                                             std::to_string(output.defaultSteps) :
                                                             "between " + std::to_string(*output.minSteps) + " and " +
                                                             std::to_string(*output.maxSteps));
@@ -2021,7 +2020,7 @@ protected:
                     if (!slavedescription::isTransportProtocolSupported(slaveDescription,
                                                                         networkInfo.getTransportProtocol())) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_TRANSPORT_PROTOCOL, networkInfo.getTransportProtocol());
+                        Log(INVALID_TRANSPORT_PROTOCOL, (uint8_t) networkInfo.getTransportProtocol());
 #endif
                         error = DcpError::INVALID_TRANSPORT_PROTOCOL;
                         break;
@@ -2034,7 +2033,7 @@ protected:
                     if (!slavedescription::isTransportProtocolSupported(slaveDescription,
                                                                         networkInfo.getTransportProtocol())) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_TRANSPORT_PROTOCOL, networkInfo.getTransportProtocol());
+                        Log(INVALID_TRANSPORT_PROTOCOL, (uint8_t) networkInfo.getTransportProtocol());
 #endif
                         error = DcpError::INVALID_TRANSPORT_PROTOCOL;
                     }
@@ -2079,18 +2078,18 @@ protected:
                 }
                 case DcpPduType::CFG_parameter: {
                     DcpPduCfgParameter &setParameter = static_cast<DcpPduCfgParameter &>(msg);
-                    if (!slavedescription::parameterExists(slaveDescription, setParameter.getParameterVr())) {
+                    if (!slavedescription::parameterExists(slaveDescriptionIndex, setParameter.getParameterVr())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_VALUE_REFERENCE_PARAMETER, setParameter.getParameterVr());
 #endif
                         error = DcpError::INVALID_VALUE_REFERENCE;
                         break;
                     }
-                    if (!castAllowed(slavedescription::getDataType(slaveDescription, setParameter.getParameterVr()),
+                    if (!castAllowed(slavedescription::getDataType(slaveDescriptionIndex, setParameter.getParameterVr()),
                                      setParameter.getSourceDataType())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_SOURCE_DATA_TYPE, setParameter.getSourceDataType(),
-                            slavedescription::getDataType(slaveDescription, setParameter.getParameterVr()));
+                            slavedescription::getDataType(slaveDescriptionIndex, setParameter.getParameterVr()));
 #endif
                         if (error == DcpError::NONE) {
                             error = DcpError::INVALID_SOURCE_DATA_TYPE;
@@ -2101,7 +2100,7 @@ protected:
                 case DcpPduType::CFG_tunable_parameter: {
                     DcpPduCfgTunableParameter configTunableParameter = static_cast<DcpPduCfgTunableParameter &>(msg);
 
-                    if (!slavedescription::parameterExists(slaveDescription, configTunableParameter.getParameterVr())) {
+                    if (!slavedescription::parameterExists(slaveDescriptionIndex, configTunableParameter.getParameterVr())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_VALUE_REFERENCE_PARAMETER, configTunableParameter.getParameterVr());
 #endif
@@ -2109,11 +2108,11 @@ protected:
                         break;
                     }
                     if (!castAllowed(
-                            slavedescription::getDataType(slaveDescription, configTunableParameter.getParameterVr()),
+                            slavedescription::getDataType(slaveDescriptionIndex, configTunableParameter.getParameterVr()),
                             configTunableParameter.getSourceDataType())) {
 #if defined(DEBUG) || defined(LOGGING)
                         Log(INVALID_SOURCE_DATA_TYPE, configTunableParameter.getSourceDataType(),
-                            slavedescription::getDataType(slaveDescription, configTunableParameter.getParameterVr()));
+                            slavedescription::getDataType(slaveDescriptionIndex, configTunableParameter.getParameterVr()));
 #endif
                         if (error == DcpError::NONE) {
                             error = DcpError::INVALID_SOURCE_DATA_TYPE;
@@ -2127,7 +2126,7 @@ protected:
                     if (!slavedescription::isTransportProtocolSupported(slaveDescription,
                                                                         paramNetworkInfo.getTransportProtocol())) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_TRANSPORT_PROTOCOL, paramNetworkInfo.getTransportProtocol());
+                        Log(INVALID_TRANSPORT_PROTOCOL, (uint8_t) paramNetworkInfo.getTransportProtocol());
 #endif
                         error = DcpError::INVALID_TRANSPORT_PROTOCOL;
                     }
@@ -2219,7 +2218,7 @@ protected:
 
                     if ((uint8_t) setLogging.getLogMode() > 1) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_LOG_MODE, setLogging.getLogMode());
+                        Log(INVALID_LOG_MODE, (uint8_t) setLogging.getLogMode());
 #endif
                         if (error == DcpError::NONE) {
                             error = DcpError::INVALID_LOG_MODE;
@@ -2231,7 +2230,7 @@ protected:
                     DcpPduCfgScope &setScope = static_cast<DcpPduCfgScope &>(msg);
                     if ((uint8_t) setScope.getScope() > 2) {
 #if defined(DEBUG) || defined(LOGGING)
-                        Log(INVALID_SCOPE, setScope.getScope());
+                        Log(INVALID_SCOPE, (uint8_t) setScope.getScope());
 #endif
                         error = DcpError::INVALID_SCOPE;
                         break;
@@ -2320,13 +2319,20 @@ case DcpDataType::input: \
             delete ent.second;
         }
         outputBuffer.clear();
+        outputBufferCapacity.clear();
     }
 
     void clearConfig() {
         driver.stop();
+        std::lock_guard<StructureLock> lock(structureLock);
 
         inputAssignment.clear();
         configuredInPos.clear();
+        inputDecodeSteps.clear();
+        inputDecodePlan.clear();
+        inputPduSize.clear();
+        outputSerializationSteps.clear();
+        outputSerializationPlan.clear();
 
         outputAssignment.clear();
         configuredOutPos.clear();
@@ -2334,11 +2340,14 @@ case DcpDataType::input: \
 
         configuredParamPos.clear();
         paramAssignment.clear();
+        maxConsecMissedPduData.clear();
+        maxConsecMissedPduParam.clear();
 
         segNumsOut.clear();
         segNumsIn.clear();
         dataSegNumsOut.clear();
         dataSegNumsIn.clear();
+        parameterSegNumsIn.clear();
 
         steps.clear();
         runningScope.clear();
@@ -2370,22 +2379,226 @@ case DcpDataType::input: \
 #endif
     }
 
+    /**
+     * Place the payloads of all fixed size values in one cache line aligned block. Inputs, outputs and
+     * parameters are grouped by data id resp. parameter id in wire order, each group starting at a new
+     * cache line, followed by all remaining values. The current content of every value is kept.
+     * Values which are resized afterwards by a structural parameter get an own heap buffer again and
+     * are moved back into the arena at the next call.
+     */
+    void layoutValueArena() {
+        std::vector<std::pair<MultiDimValue *, size_t>> layout;
+        std::set<valueReference_t> placed;
+        size_t size = 0;
+        auto place = [&](valueReference_t valueReference) {
+            auto it = values.find(valueReference);
+            if (it == values.end() || !it->second->isFixedSize() || placed.count(valueReference)) {
+                return;
+            }
+            MultiDimValue *value = it->second;
+            size = ValueArena::align(size, value->getBaseSize());
+            layout.push_back(std::make_pair(value, size));
+            placed.insert(valueReference);
+            size += value->getSize();
+        };
+        for (auto const &assignment : inputAssignment) {
+            size = ValueArena::align(size, ValueArena::CACHE_LINE_SIZE);
+            for (auto const &pos : assignment.second) {
+                place(pos.second.first);
+            }
+        }
+        for (auto const &assignment : outputAssignment) {
+            size = ValueArena::align(size, ValueArena::CACHE_LINE_SIZE);
+            for (auto const &pos : assignment.second) {
+                place(pos.second);
+            }
+        }
+        for (auto const &assignment : paramAssignment) {
+            size = ValueArena::align(size, ValueArena::CACHE_LINE_SIZE);
+            for (auto const &pos : assignment.second) {
+                place(pos.second.first);
+            }
+        }
+        size = ValueArena::align(size, ValueArena::CACHE_LINE_SIZE);
+        for (auto const &entry : values) {
+            place(entry.first);
+        }
+
+        ValueArena *newArena = new ValueArena(size);
+        for (auto const &entry : layout) {
+            entry.first->relocate(newArena->getBlock() + entry.second);
+        }
+        delete valueArena;
+        valueArena = newArena;
+    }
+
+    /**
+     * Resolve the input assignments into a flat list of decode steps, so receiving DAT_input_output
+     * does neither need any map lookup nor any allocation. Has to be called again whenever a
+     * MultiDimValue of an input is replaced.
+     */
+    void compileInputDecodePlan() {
+        inputDecodeSteps.clear();
+        inputDecodePlan.clear();
+        inputPduSize.clear();
+        if (inputAssignment.empty()) {
+            return;
+        }
+        inputDecodePlan.resize(inputAssignment.rbegin()->first + 1, std::make_pair(0, 0));
+        inputPduSize.resize(inputAssignment.rbegin()->first + 1, 0);
+        for (auto const &assignment : inputAssignment) {
+            size_t first = inputDecodeSteps.size();
+            //same rule as the length check in checkForError
+            size_t pduSize = 5;
+            for (auto const &pos : assignment.second) {
+                valueReference_t valueReference = pos.second.first;
+                MultiDimValue *value = values[valueReference];
+                if (pduSize != 0 && pos.second.second != DcpDataType::binary &&
+                    pos.second.second != DcpDataType::string) {
+                    pduSize += getDcpDataTypeSize(pos.second.second) * value->getNumberOfAssignments();
+                } else {
+                    pduSize = 0;
+                }
+                InputDecodeStep step;
+                step.destination = value->getValue<uint8_t *>();
+                step.sourceDataType = pos.second.second;
+                step.converter = getConverter(value->getDataType(), pos.second.second);
+                step.count = value->getNumberOfAssignments();
+                step.baseSize = value->getBaseSize();
+#ifdef DEBUG
+                step.valueReference = valueReference;
+                step.dataType = value->getDataType();
+#endif
+                inputDecodeSteps.push_back(step);
+            }
+            inputDecodePlan[assignment.first] = std::make_pair(first, inputDecodeSteps.size());
+            inputPduSize[assignment.first] = pduSize;
+        }
+    }
+
+    /**
+     * Copy the payload of a DAT_input_output PDU into the inputs, following the decode plan of its data id.
+     * The caller holds structureLock shared.
+     */
+    void decodeInputs(DcpPduDatInputOutput &data) {
+        const uint8_t *payload = data.getPayload();
+        const std::pair<size_t, size_t> &range = inputDecodePlan[data.getDataId()];
+        for (size_t i = range.first; i < range.second; i++) {
+            const InputDecodeStep &step = inputDecodeSteps[i];
+            payload += step.converter(step.destination, payload, step.count, step.baseSize);
+#ifdef DEBUG
+            Log(ASSIGNED_INPUT, step.valueReference, step.sourceDataType, step.dataType);
+#endif
+        }
+    }
+
+    /**
+     * Bytes the fixed size outputs of one data id take in its DAT_input_output PDU.
+     */
+    size_t getFixedOutputSize(const std::map<pos_t, valueReference_t> &assignment) {
+        size_t fixedSize = 0;
+        for (auto const &pos : assignment) {
+            MultiDimValue *value = values[pos.second];
+            if (value->isFixedSize()) {
+                fixedSize += value->getNumberOfAssignments() * value->getBaseSize();
+            }
+        }
+        return fixedSize;
+    }
+
+    /**
+     * Resolve the output assignments into a flat list of serialization steps. Fixed size outputs
+     * which are adjacent in memory are merged into a single run. Has to be called again whenever
+     * a MultiDimValue of an output is replaced.
+     *
+     * The output buffer of a data id holds its fixed size outputs, but at least bufferSize bytes for
+     * variable size outputs. It is created here and grows with resized outputs. A data id whose fixed
+     * size outputs exceed MAX_OUTPUT_PAYLOAD_SIZE gets no plan and is not sent.
+     */
+    void compileOutputSerializationPlan() {
+        outputSerializationSteps.clear();
+        outputSerializationPlan.clear();
+        if (outputAssignment.empty()) {
+            return;
+        }
+        OutputSerializationPlan unused = {nullptr, 0, 0, 0};
+        outputSerializationPlan.resize(outputAssignment.rbegin()->first + 1, unused);
+        for (auto const &assignment : outputAssignment) {
+            const size_t fixedSize = getFixedOutputSize(assignment.second);
+            if (fixedSize > MAX_OUTPUT_PAYLOAD_SIZE) {
+                //rejected by STC_prepare, but a structural parameter may resize an output later on
+#if defined(DEBUG) || defined(LOGGING)
+                Log(OUTPUT_PDU_TOO_LARGE, assignment.first, (uint64_t) fixedSize);
+#endif
+                continue;
+            }
+            size_t capacity = std::max<size_t>(bufferSize, fixedSize);
+            if (capacity > MAX_OUTPUT_PAYLOAD_SIZE) {
+                capacity = MAX_OUTPUT_PAYLOAD_SIZE;
+            }
+            DcpPduDatInputOutput *&pdu = outputBuffer[assignment.first];
+            if (pdu == nullptr || outputBufferCapacity[assignment.first] < capacity) {
+                delete pdu;
+#ifdef DEBUG
+                Log(DATA_BUFFER_CREATED, assignment.first, (uint32_t) capacity);
+#endif
+                pdu = new DcpPduDatInputOutput(0, assignment.first, (uint16_t) capacity);
+                outputBufferCapacity[assignment.first] = capacity;
+            }
+
+            size_t first = outputSerializationSteps.size();
+            for (auto const &pos : assignment.second) {
+                MultiDimValue *value = values[pos.second];
+                const uint8_t *source = value->getValue<uint8_t *>();
+                if (value->isFixedSize()) {
+                    size_t length = value->getNumberOfAssignments() * value->getBaseSize();
+                    if (outputSerializationSteps.size() > first) {
+                        OutputSerializationStep &last = outputSerializationSteps.back();
+                        if (last.count == 0 && last.source + last.length == source) {
+                            last.length += length;
+                            continue;
+                        }
+                    }
+                    OutputSerializationStep step = {source, length, 0, value->getBaseSize()};
+                    outputSerializationSteps.push_back(step);
+                } else {
+                    OutputSerializationStep step = {source, 0, value->getNumberOfAssignments(),
+                                                    value->getBaseSize()};
+                    outputSerializationSteps.push_back(step);
+                }
+            }
+            OutputSerializationPlan plan = {pdu, first, outputSerializationSteps.size(),
+                                            PDU_LENGTH_INDICATOR_SIZE + 5 + outputBufferCapacity[assignment.first]};
+            outputSerializationPlan[assignment.first] = plan;
+        }
+        outputBatch.reserve(outputAssignment.size());
+    }
+
     void updateStructualDependencies(uint64_t valueReference, size_t value) {
         for (auto const &dependency: structualDependencies[valueReference]) {
             uint64_t vrToUpdate = dependency.first;
             size_t pos = dependency.second;
             std::vector<size_t> newDimensions(values[vrToUpdate]->getDimensions());
             newDimensions[pos] = value;
-            if (slavedescription::inputExists(slaveDescription, valueReference) ||
-                slavedescription::outputExists(slaveDescription, valueReference)) {
-                values[vrToUpdate] = new MultiDimValue(slavedescription::getDataType(slaveDescription, vrToUpdate),
-                                                       values[vrToUpdate]->getBaseSize(), newDimensions);
+            if (slavedescription::inputExists(slaveDescriptionIndex, valueReference) ||
+                slavedescription::outputExists(slaveDescriptionIndex, valueReference)) {
+                //the resized value leaves the arena until the next STC_configure
+                MultiDimValue *oldValue = values[vrToUpdate];
+                values[vrToUpdate] = new MultiDimValue(slavedescription::getDataType(slaveDescriptionIndex, vrToUpdate),
+                                                       oldValue->getBaseSize(), newDimensions);
+                delete oldValue;
             } else {
                 updatedStructure[vrToUpdate] = new MultiDimValue(
-                        slavedescription::getDataType(slaveDescription, vrToUpdate),
+                        slavedescription::getDataType(slaveDescriptionIndex, vrToUpdate),
                         values[vrToUpdate]->getBaseSize(), newDimensions);
             }
         }
+        if (!inputDecodePlan.empty()) {
+            compileInputDecodePlan();
+        }
+        if (!outputSerializationPlan.empty()) {
+            compileOutputSerializationPlan();
+        }
     }
 
     void checkForUpdatedStructure(uint64_t valueReference) {
@@ -2393,6 +2606,12 @@ case DcpDataType::input: \
             delete values[valueReference];
             values[valueReference] = updatedStructure[valueReference];
             updatedStructure.erase(valueReference);
+            if (!inputDecodePlan.empty()) {
+                compileInputDecodePlan();
+            }
+            if (!outputSerializationPlan.empty()) {
+                compileOutputSerializationPlan();
+            }
         }
     }
 
@@ -2407,15 +2626,13 @@ case DcpDataType::input: \
             logListener(logEntry);
         }
 
-        if (logOnNotification[logEntry.getCategory()][logEntry.getLevel()]) {
+        if (logOnNotification.isEnabled(logEntry.getCategory(), logEntry.getLevel())) {
             DcpPduNtfLog ntfLog = {dcpId, logEntry.getId(), logEntry.getTime(), logEntry.serialize(),
                                    logEntry.serializedSize()};
             driver.send(ntfLog);
         };
-        if (logOnRequest[logEntry.getCategory()][logEntry.getLevel()]) {
-            logBuffer[logEntry.getCategory()].push_back({logEntry.serialize(), logEntry.serializedSize()});
-        } else {
-            delete[] payload;
+        if (logOnRequest.isEnabled(logEntry.getCategory(), logEntry.getLevel())) {
+            logBuffer.push(logEntry.getCategory(), payload, size);
         }
     }
 
@@ -2453,7 +2670,7 @@ case DcpDataType::input: \
 
     virtual void updateLastStateRequest() = 0;
 
-    virtual void sendOutputs(std::vector<uint16_t> dataIdsToSend) = 0;
+    virtual void sendOutputs(const std::vector<dataId_t> &dataIdsToSend) = 0;
 
 };
 
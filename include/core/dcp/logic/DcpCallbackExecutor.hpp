@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_DCPCALLBACKEXECUTOR_HPP
+#define DCPLIB_DCPCALLBACKEXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Fixed pool of worker threads executing callbacks.
+ * Tasks are submitted through a bounded lock-free queue, so submitting never blocks and never creates a thread.
+ * Idle workers sleep on a condition variable, which is only touched by a submitter if a worker sleeps.
+ */
+class DcpCallbackExecutor {
+public:
+    /**
+     * Start the workers
+     * @param workers Number of worker threads, at least one
+     * @param capacity Maximum number of pending tasks, rounded up to a power of two
+     * @param cpus CPUs the workers are pinned to, worker i is pinned to cpus[i % cpus.size()]. Empty means no pinning
+     */
+    explicit DcpCallbackExecutor(size_t workers = 2, size_t capacity = 256, const std::vector<int> &cpus = {}) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        slots = new Slot[size];
+        for (size_t i = 0; i < size; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        if (workers == 0) {
+            workers = 1;
+        }
+        for (size_t i = 0; i < workers; i++) {
+            threads.emplace_back(&DcpCallbackExecutor::work, this);
+            if (!cpus.empty()) {
+                pin(threads.back(), cpus[i % cpus.size()]);
+            }
+        }
+    }
+
+    /**
+     * Executes all pending tasks and joins the workers
+     */
+    ~DcpCallbackExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopped = true;
+        }
+        cv.notify_all();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        delete[] slots;
+    }
+
+    DcpCallbackExecutor(const DcpCallbackExecutor &) = delete;
+
+    DcpCallbackExecutor &operator=(const DcpCallbackExecutor &) = delete;
+
+    /**
+     * Submit a task to the pool
+     * @param task Task to execute on one of the workers
+     * @return False if the queue is full. The task was not submitted and is left untouched
+     */
+    bool execute(std::function<void()> &&task) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &slots[position & mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        slot->task = std::move(task);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_one();
+        }
+        return true;
+    }
+
+    inline size_t getWorkerCount() const {
+        return threads.size();
+    }
+
+    /**
+     * @return True if called by a task, i.e. on one of the workers
+     */
+    bool isWorkerThread() const {
+        const std::thread::id current = std::this_thread::get_id();
+        for (const std::thread &thread : threads) {
+            if (thread.get_id() == current) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @return Number of submitted tasks, which are not yet taken by a worker. Approximated if called concurrently
+     */
+    inline size_t getQueueDepth() const {
+        const size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        const size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    inline size_t getCapacity() const {
+        return mask + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::function<void()> task;
+    };
+
+    Slot *slots;
+    size_t mask;
+    std::atomic<size_t> enqueuePosition{0};
+    std::atomic<size_t> dequeuePosition{0};
+
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::atomic<size_t> sleeping{0};
+    bool stopped = false;
+
+    bool tryDequeue(std::function<void()> &task) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &slots[position & mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t) sequence - (intptr_t) (position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        task = std::move(slot->task);
+        slot->task = nullptr;
+        slot->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    void work() {
+        std::function<void()> task;
+        for (;;) {
+            if (tryDequeue(task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mtx);
+            sleeping.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // a submitter either sees the sleeping worker or the worker sees the submitted task
+            cv.wait(lock, [this, &task] { return tryDequeue(task) || stopped; });
+            sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (task) {
+                lock.unlock();
+                task();
+                task = nullptr;
+            } else if (stopped) {
+                return;
+            }
+        }
+    }
+
+    static void pin(std::thread &thread, int cpu) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+        (void) thread;
+        (void) cpu;
+#endif
+    }
+};
+
+#endif //DCPLIB_DCPCALLBACKEXECUTOR_HPP
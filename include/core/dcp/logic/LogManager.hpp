@@ -12,11 +12,52 @@
 
 #include <cstdint>
 #include <dcp/model/LogTemplate.hpp>
+#include <dcp/logic/LogRing.hpp>
+#include <atomic>
 #include <functional>
 
+/**
+ * Levels of each log category somebody consumes. Log checks it before a payload is built.
+ */
+class LogFilter {
+public:
+    LogFilter() {
+        for (auto &levels : enabledLevels) {
+            levels.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    inline bool isEnabled(uint8_t category, DcpLogLevel level) const {
+        return (enabledLevels[category].load(std::memory_order_relaxed) >> (uint8_t) level) & 1;
+    }
+
+    void setEnabled(uint8_t category, DcpLogLevel level, bool enabled) {
+        if (enabled) {
+            enabledLevels[category].fetch_or((uint8_t) (1 << (uint8_t) level), std::memory_order_relaxed);
+        } else {
+            enabledLevels[category].fetch_and((uint8_t) ~(1 << (uint8_t) level), std::memory_order_relaxed);
+        }
+    }
+
+    void enableAll() {
+        for (auto &levels : enabledLevels) {
+            levels.store(0xFF, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<uint8_t> enabledLevels[256];
+};
 
 struct LogManager{
+    //the payload is only valid during the call
     std::function<void(const LogTemplate&, uint8_t*, size_t)> consume;
+    //allocates with new[], used if no ring is running
     std::function<uint8_t*(size_t)> alloc;
+    //if set and running, log records are written into the ring instead of being passed to consume directly.
+    //Records are dropped while the ring is full
+    LogRing *ring;
+    //if set, only records of enabled levels are logged
+    const LogFilter *filter;
 };
 #endif //DCPLIB_LOGMANAGER_H
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_LOGREQUESTBUFFER_H
+#define DCPLIB_LOGREQUESTBUFFER_H
+
+#include <dcp/model/DcpTypes.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Log entries of the categories with DcpLogMode::LOG_ON_REQUEST until the master requests them with INF_log.
+ * Each category has a byte ring of fixed capacity, allocated on its first entry. Entries are stored back to back
+ * without framing, so a sequence of them is copied into an RSP_log_ack as is.
+ */
+class LogRequestBuffer {
+public:
+    enum class Policy : uint8_t {
+        //entries which do not fit are discarded
+        DROP_NEWEST,
+        //the oldest entries are discarded until the new one fits
+        OVERWRITE_OLDEST,
+    };
+
+    /**
+     * @param capacity Bytes per category
+     * @param policy What happens if the ring of a category is full
+     */
+    LogRequestBuffer(size_t capacity = 16 * 1024, Policy policy = Policy::OVERWRITE_OLDEST) :
+            capacity(capacity), policy(policy) {}
+
+    LogRequestBuffer(const LogRequestBuffer &) = delete;
+
+    LogRequestBuffer &operator=(const LogRequestBuffer &) = delete;
+
+    /**
+     * Change capacity and policy. Buffered entries are discarded.
+     */
+    void configure(size_t capacity, Policy policy) {
+        std::unique_lock<std::mutex> lock(mutex);
+        this->capacity = capacity;
+        this->policy = policy;
+        for (auto &ring : rings) {
+            ring.reset();
+        }
+    }
+
+    void push(logCategory_t category, const uint8_t *payload, size_t size) {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::unique_ptr<Ring> &ring = rings[category];
+        if (!ring) {
+            ring.reset(new Ring(capacity));
+        }
+        if (size > capacity || size > UINT16_MAX) {
+            ring->dropped++;
+            return;
+        }
+        while (ring->usedBytes + size > capacity || ring->entries == ring->sizes.size()) {
+            if (policy == Policy::DROP_NEWEST) {
+                ring->dropped++;
+                return;
+            }
+            ring->discardOldest();
+            ring->dropped++;
+        }
+        ring->write(payload, size);
+    }
+
+    /**
+     * Move the oldest entries of a category to destination.
+     * @param maxSize Entries are only moved if they fit completely
+     * @param maxNum Maximum number of entries
+     * @return Number of bytes written to destination
+     */
+    size_t pop(logCategory_t category, uint8_t *destination, size_t maxSize, size_t maxNum) {
+        std::unique_lock<std::mutex> lock(mutex);
+        Ring *ring = rings[category].get();
+        if (ring == nullptr) {
+            return 0;
+        }
+        size_t total = 0;
+        size_t count = 0;
+        while (count < maxNum && count < ring->entries) {
+            size_t size = ring->sizes[(ring->firstEntry + count) % ring->sizes.size()];
+            if (total + size > maxSize) {
+                break;
+            }
+            total += size;
+            count++;
+        }
+        ring->read(destination, total);
+        ring->firstEntry = (ring->firstEntry + count) % ring->sizes.size();
+        ring->entries -= count;
+        return total;
+    }
+
+    /**
+     * @return Number of entries of a category which were discarded because its ring was full
+     */
+    uint64_t getDropped(logCategory_t category) const {
+        std::unique_lock<std::mutex> lock(mutex);
+        return rings[category] ? rings[category]->dropped : 0;
+    }
+
+private:
+    struct Ring {
+        //every entry has at least time and template id, so there are never more than capacity / 9 entries
+        explicit Ring(size_t capacity) : data(std::max<size_t>(capacity, 1)),
+                                         sizes(std::max<size_t>(capacity / 9, 1)) {}
+
+        void write(const uint8_t *payload, size_t size) {
+            const size_t start = (firstByte + usedBytes) % data.size();
+            const size_t first = std::min(size, data.size() - start);
+            std::memcpy(data.data() + start, payload, first);
+            std::memcpy(data.data(), payload + first, size - first);
+            usedBytes += size;
+            sizes[(firstEntry + entries) % sizes.size()] = (uint16_t) size;
+            entries++;
+        }
+
+        void read(uint8_t *destination, size_t size) {
+            const size_t first = std::min(size, data.size() - firstByte);
+            std::memcpy(destination, data.data() + firstByte, first);
+            std::memcpy(destination + first, data.data(), size - first);
+            firstByte = (firstByte + size) % data.size();
+            usedBytes -= size;
+        }
+
+        void discardOldest() {
+            const size_t size = sizes[firstEntry];
+            firstByte = (firstByte + size) % data.size();
+            usedBytes -= size;
+            firstEntry = (firstEntry + 1) % sizes.size();
+            entries--;
+        }
+
+        std::vector<uint8_t> data;
+        std::vector<uint16_t> sizes;
+        size_t firstByte = 0;
+        size_t usedBytes = 0;
+        size_t firstEntry = 0;
+        size_t entries = 0;
+        uint64_t dropped = 0;
+    };
+
+    size_t capacity;
+    Policy policy;
+    mutable std::mutex mutex;
+    std::unique_ptr<Ring> rings[256];
+};
+
+#endif //DCPLIB_LOGREQUESTBUFFER_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_LOGRING_H
+#define DCPLIB_LOGRING_H
+
+#include <dcp/model/LogTemplate.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Bounded multi-producer/single-consumer ring of log records. All records are allocated up front.
+ * Producers reserve a record, write the payload in place and publish it, a background thread passes the
+ * published records in order to the consumer.
+ */
+class LogRing {
+public:
+    struct Record {
+        //published when sequence is position + 1, free for position + capacity when consumed
+        std::atomic<size_t> sequence;
+        const LogTemplate *logTemplate;
+        size_t size;
+        uint8_t *payload;
+        size_t position;
+    };
+
+    /**
+     * @param capacity Number of records, rounded up to a power of two
+     * @param recordSize Maximum payload size of a record, larger records are dropped
+     */
+    LogRing(size_t capacity = 1024, size_t recordSize = 512) : recordSize(recordSize) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        mask = rounded - 1;
+        records = std::vector<Record>(rounded);
+        payloads.resize(rounded * recordSize);
+        for (size_t i = 0; i < rounded; i++) {
+            records[i].sequence.store(i, std::memory_order_relaxed);
+            records[i].payload = payloads.data() + i * recordSize;
+        }
+    }
+
+    ~LogRing() {
+        stop();
+    }
+
+    LogRing(const LogRing &) = delete;
+
+    LogRing &operator=(const LogRing &) = delete;
+
+    /**
+     * Start the consumer thread. Records are only accepted while it runs.
+     * @param consume Called for every record on the consumer thread, the payload is only valid during the call
+     */
+    void start(std::function<void(const LogTemplate &, uint8_t *, size_t)> consume) {
+        if (running.load()) {
+            return;
+        }
+        this->consume = std::move(consume);
+        stopping = false;
+        running.store(true);
+        consumer = std::thread(&LogRing::run, this);
+    }
+
+    /**
+     * Stop the consumer thread after all records are consumed. Records acquired before are waited for
+     * until they are published, so none is left half written. A record acquired concurrently with stop
+     * may remain in the ring until it is started again.
+     */
+    void stop() {
+        if (!running.exchange(false)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtxWait);
+            stopping = true;
+        }
+        cvWait.notify_one();
+        if (consumer.get_id() == std::this_thread::get_id()) {
+            //stopped from a listener, the thread ends after the current record
+            consumer.detach();
+        } else {
+            consumer.join();
+        }
+    }
+
+    /**
+     * @return True while the consumer thread runs and records are accepted
+     */
+    inline bool isRunning() const {
+        return running.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Producer: reserve a record for a payload of size bytes. Every record returned must be published.
+     * @return the record or nullptr if the ring is full, the payload is larger than the record size or the
+     * consumer is not running. Records rejected because the ring is full or too large are counted as dropped.
+     */
+    inline Record *acquire(size_t size) {
+        if (!running.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        if (size > recordSize) {
+            //no allocation on the producer side, a truncated record could not be decoded
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Record &record = records[position & mask];
+            const size_t sequence = record.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    record.position = position;
+                    record.size = size;
+                    return &record;
+                }
+            } else if (difference < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Producer: hand a record returned by acquire to the consumer.
+     */
+    inline void publish(Record *record, const LogTemplate &logTemplate) {
+        record->logTemplate = &logTemplate;
+        record->sequence.store(record->position + 1, std::memory_order_release);
+        if (waiting.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(mtxWait);
+            cvWait.notify_one();
+        }
+    }
+
+    /**
+     * @return Number of records rejected because the ring was full or they were larger than the record size
+     */
+    size_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    size_t recordSize;
+    size_t mask;
+    std::vector<Record> records;
+    std::vector<uint8_t> payloads;
+
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+    std::atomic<size_t> dropped{0};
+
+    std::function<void(const LogTemplate &, uint8_t *, size_t)> consume;
+    std::thread consumer;
+    std::atomic<bool> running{false};
+    std::atomic<bool> waiting{false};
+    bool stopping = false;
+    std::mutex mtxWait;
+    std::condition_variable cvWait;
+
+    bool consumeNext() {
+        Record &record = records[dequeuePosition & mask];
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            return false;
+        }
+        consume(*record.logTemplate, record.payload, record.size);
+        record.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        dequeuePosition++;
+        return true;
+    }
+
+    void run() {
+        for (;;) {
+            while (consumeNext()) {}
+            std::unique_lock<std::mutex> lock(mtxWait);
+            if (stopping) {
+                lock.unlock();
+                //every acquired record is consumed, producers publish shortly after acquire
+                while (dequeuePosition != enqueuePosition.load(std::memory_order_acquire)) {
+                    if (!consumeNext()) {
+                        std::this_thread::yield();
+                    }
+                }
+                return;
+            }
+            waiting.store(true, std::memory_order_seq_cst);
+            if (!consumeReady()) {
+                //the timeout bounds the delay if a producer did not see the waiting flag yet
+                cvWait.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    bool consumeReady() {
+        return records[dequeuePosition & mask].sequence.load(std::memory_order_seq_cst) == dequeuePosition + 1;
+    }
+};
+
+#endif //DCPLIB_LOGRING_H
@@ -26,24 +26,71 @@ public:
 private:
 
 protected:
-    LogManager logManager;
+    LogManager logManager{};
 
 public:
+    inline bool isLogged(uint8_t category, DcpLogLevel level) const {
+        return logManager.filter == nullptr || logManager.filter->isEnabled(category, level);
+    }
+
+    /**
+     * False at compile time if the descriptor is below the minimum level of its category.
+     * Use it to skip building expensive arguments.
+     */
+    template<uint8_t Category, DcpLogLevel Level, DcpDataType... Types>
+    inline bool isLogged(const LogDescriptor<Category, Level, Types...> &) const {
+        return LogDescriptor<Category, Level, Types...>::compiledIn && isLogged(Category, Level);
+    }
+
+    template<uint8_t Category, DcpLogLevel Level, DcpDataType... Types, typename ... Args>
+    inline void Log(const LogDescriptor<Category, Level, Types...> &logTemplate, const Args... args) {
+        static_assert(sizeof...(Types) == sizeof...(Args), "Number of arguments does not match the log template");
+        static_assert(DcpLogHelper::ArgumentsMatch<DcpLogHelper::DataTypes<Types...>, Args...>::value,
+                      "Argument types do not match the data types of the log template");
+        if (LogDescriptor<Category, Level, Types...>::compiledIn && isLogged(Category, Level)) {
+            writeRecord(logTemplate, args...);
+        }
+    }
+
     template<typename ... Args>
     inline void Log(const LogTemplate &logTemplate, const Args... args) {
+        if (!isLogged(logTemplate.category, logTemplate.level)) {
+            return;
+        }
+        DcpLogHelper::checkDataTypes(logTemplate, 0, args...);
+        writeRecord(logTemplate, args...);
+    }
+
+private:
+    template<typename ... Args>
+    inline void writeRecord(const LogTemplate &logTemplate, const Args... args) {
         using namespace std::chrono;
 
-        DcpLogHelper::checkDataTypes(logTemplate, 0, args...);
         size_t size = DcpLogHelper::size(args...);
         const auto logTime = time_point_cast<microseconds>(system_clock::now());
 
+        if (logManager.ring != nullptr && logManager.ring->isRunning()) {
+            //only the consumer thread of the ring consumes, on overload the record is dropped and counted by the ring
+            LogRing::Record *record = logManager.ring->acquire(size + 9);
+            if (record != nullptr) {
+                fillRecord(record->payload, logTime, logTemplate, args...);
+                logManager.ring->publish(record, logTemplate);
+            }
+            return;
+        }
         uint8_t* payload = logManager.alloc(size + 9);
-        *((int64_t *) payload) = (int64_t) duration_cast<seconds>(logTime.time_since_epoch()).count();
-        *((uint8_t *) payload + 8) = logTemplate.id;
+        fillRecord(payload, logTime, logTemplate, args...);
+        logManager.consume(logTemplate, payload, size + 9);
+        delete[] payload;
+    }
 
+    template<typename Time, typename ... Args>
+    inline void fillRecord(uint8_t *payload, const Time &logTime, const LogTemplate &logTemplate, const Args... args) {
+        using namespace std::chrono;
 
+        *((int64_t *) payload) = (int64_t) duration_cast<seconds>(logTime.time_since_epoch()).count();
+        *((uint8_t *) payload + 8) = logTemplate.id;
         DcpLogHelper::applyFields(payload + 9, args...);
-        logManager.consume(logTemplate, payload, size + 9);
     }
 };
 #endif //DCPLIB_LOGABLE_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_PDUADMISSION_H
+#define DCPLIB_PDUADMISSION_H
+
+#include <dcp/model/constant/DcpPduType.hpp>
+#include <dcp/model/constant/DcpState.hpp>
+
+#include <cstdint>
+
+/**
+ * PDUs a slave accepts in each state, compiled into one 256 bit mask of type ids per state.
+ */
+namespace PduAdmission {
+
+    struct Mask {
+        uint64_t words[4];
+    };
+
+    constexpr uint64_t bit(unsigned index, DcpPduType type) {
+        return ((uint8_t) type >> 6) == index ? (uint64_t) 1 << ((uint8_t) type & 63) : 0;
+    }
+
+    constexpr uint64_t word(unsigned index) {
+        return 0;
+    }
+
+    //bits of the types in the index-th word of a mask
+    template<typename... Types>
+    constexpr uint64_t word(unsigned index, DcpPduType type, Types... types) {
+        return bit(index, type) | word(index, types...);
+    }
+
+    template<typename... Types>
+    constexpr Mask allow(Types... types) {
+        return {{word(0, types...), word(1, types...), word(2, types...), word(3, types...)}};
+    }
+
+    //indexed by DcpState
+    static constexpr Mask allowed[] = {
+            /* ALIVE */
+            allow(DcpPduType::STC_register, DcpPduType::INF_state),
+            /* CONFIGURATION */
+            allow(DcpPduType::STC_deregister, DcpPduType::STC_prepare, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::CFG_steps, DcpPduType::CFG_time_res, DcpPduType::CFG_input, DcpPduType::CFG_output,
+                  DcpPduType::CFG_clear, DcpPduType::CFG_target_network_information,
+                  DcpPduType::CFG_source_network_information, DcpPduType::CFG_tunable_parameter,
+                  DcpPduType::CFG_parameter, DcpPduType::CFG_param_network_information, DcpPduType::CFG_logging,
+                  DcpPduType::CFG_scope),
+            /* PREPARING */
+            allow(DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log),
+            /* PREPARED */
+            allow(DcpPduType::STC_configure, DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log),
+            /* CONFIGURING */
+            allow(DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log),
+            /* CONFIGURED */
+            allow(DcpPduType::STC_initialize, DcpPduType::STC_stop, DcpPduType::STC_run, DcpPduType::INF_state,
+                  DcpPduType::INF_log, DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* INITIALIZING */
+            allow(DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log, DcpPduType::DAT_input_output,
+                  DcpPduType::DAT_parameter),
+            /* INITIALIZED */
+            allow(DcpPduType::STC_send_outputs, DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* SENDING_I */
+            allow(DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log, DcpPduType::DAT_input_output,
+                  DcpPduType::DAT_parameter),
+            /* SYNCHRONIZING */
+            allow(DcpPduType::STC_do_step, DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* SYNCHRONIZED */
+            allow(DcpPduType::STC_run, DcpPduType::STC_do_step, DcpPduType::STC_stop, DcpPduType::INF_state,
+                  DcpPduType::INF_log, DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* RUNNING */
+            allow(DcpPduType::STC_do_step, DcpPduType::STC_stop, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* COMPUTING */
+            allow(DcpPduType::STC_send_outputs, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* COMPUTED */
+            allow(DcpPduType::STC_send_outputs, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* SENDING_D */
+            allow(DcpPduType::INF_state, DcpPduType::INF_log, DcpPduType::DAT_input_output,
+                  DcpPduType::DAT_parameter),
+            /* STOPPING */
+            allow(DcpPduType::INF_state, DcpPduType::INF_log, DcpPduType::DAT_input_output,
+                  DcpPduType::DAT_parameter),
+            /* STOPPED */
+            allow(DcpPduType::STC_deregister, DcpPduType::STC_reset, DcpPduType::INF_state, DcpPduType::INF_log,
+                  DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+            /* ERROR_HANDLING */
+            allow(DcpPduType::INF_state, DcpPduType::INF_error, DcpPduType::INF_log, DcpPduType::DAT_input_output,
+                  DcpPduType::DAT_parameter),
+            /* ERROR_RESOLVED */
+            allow(DcpPduType::STC_reset, DcpPduType::STC_deregister, DcpPduType::INF_state, DcpPduType::INF_error,
+                  DcpPduType::INF_log, DcpPduType::DAT_input_output, DcpPduType::DAT_parameter),
+    };
+
+    static_assert(sizeof(allowed) / sizeof(Mask) == (size_t) DcpState::ERROR_RESOLVED + 1,
+                  "One mask for every DcpState");
+
+    /**
+     * @return True if a slave in the given state accepts PDUs of the given type
+     */
+    inline bool isAllowed(DcpState state, DcpPduType type) {
+        const uint8_t stateIndex = (uint8_t) state;
+        const uint8_t typeId = (uint8_t) type;
+        return stateIndex < sizeof(allowed) / sizeof(Mask) &&
+               ((allowed[stateIndex].words[typeId >> 6] >> (typeId & 63)) & 1) != 0;
+    }
+}
+
+#endif //DCPLIB_PDUADMISSION_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_SEQUENCETABLE_H
+#define DCPLIB_SEQUENCETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Sequence ids of dcp ids, data ids or param ids. Entries are stored densely, ids are remapped to their index
+ * by a direct lookup table. Ids which are not known yet get an entry on first access, use reserve to create them
+ * up front (e.g. at configure time) so the hot path never allocates.
+ */
+class SequenceTable {
+public:
+    struct Entry {
+        //last seq. id which was send out or received
+        uint16_t seqId;
+        //PDUs skipped between two received seq. ids
+        uint32_t missed;
+        //received seq. ids which were not newer than the last one
+        uint32_t duplicates;
+    };
+
+    Entry &operator[](uint16_t id) {
+        if (id < indices.size() && indices[id] != 0) {
+            return entries[indices[id] - 1];
+        }
+        return create(id);
+    }
+
+    /**
+     * @return Entry of the id, nullptr if it was never accessed
+     */
+    const Entry *find(uint16_t id) const {
+        if (id < indices.size() && indices[id] != 0) {
+            return &entries[indices[id] - 1];
+        }
+        return nullptr;
+    }
+
+    void reserve(uint16_t id) {
+        operator[](id);
+    }
+
+    void clear() {
+        indices.clear();
+        entries.clear();
+    }
+
+    /**
+     * Accept seqId if it directly follows the last one, as expected for control PDUs.
+     * @return Difference to the last seq. id
+     */
+    uint16_t checkNext(uint16_t id, uint16_t seqId) {
+        Entry &entry = operator[](id);
+        const uint16_t diff = seqId - entry.seqId;
+        if (diff == 1) {
+            entry.seqId = seqId;
+        } else {
+            count(entry, diff);
+        }
+        return diff;
+    }
+
+    /**
+     * Accept seqId if it is newer than the last one, in serial number arithmetic so it survives the wrap around.
+     * @return Difference to the last seq. id
+     */
+    uint16_t checkNewer(uint16_t id, uint16_t seqId) {
+        Entry &entry = operator[](id);
+        const uint16_t diff = seqId - entry.seqId;
+        if (diff != 0 && diff < 0x8000) {
+            entry.seqId = seqId;
+        }
+        count(entry, diff);
+        return diff;
+    }
+
+    /**
+     * @return Seq. id to send next for the id
+     */
+    uint16_t next(uint16_t id) {
+        return operator[](id).seqId++;
+    }
+
+private:
+    static void count(Entry &entry, uint16_t diff) {
+        if (diff == 0 || diff >= 0x8000) {
+            entry.duplicates++;
+        } else if (diff > 1) {
+            entry.missed += diff - 1;
+        }
+    }
+
+    Entry &create(uint16_t id) {
+        if (id >= indices.size()) {
+            indices.resize((size_t) id + 1, 0);
+        }
+        entries.push_back({0, 0, 0});
+        indices[id] = (uint32_t) entries.size();
+        return entries.back();
+    }
+
+    //index + 1 in entries, 0 if the id has no entry
+    std::vector<uint32_t> indices;
+    std::vector<Entry> entries;
+};
+
+#endif //DCPLIB_SEQUENCETABLE_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_STRUCTURELOCK_H
+#define DCPLIB_STRUCTURELOCK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * Readers-writer lock between the data path of a manager and rebuilds of the structures it reads, e.g. the
+ * input decode plan. Readers (DAT_input_output PDUs of different sockets, sending outputs) run concurrently
+ * and only touch an atomic counter. A writer waits until all readers left, new readers wait for the writer.
+ * Neither side is recursive. Exclusive access is BasicLockable, so it can be used with std::lock_guard.
+ */
+class StructureLock {
+public:
+    /**
+     * Holds shared access for its lifetime
+     */
+    class Shared {
+    public:
+        explicit Shared(StructureLock &lock) : lock(lock) {
+            lock.lockShared();
+        }
+
+        ~Shared() {
+            lock.unlockShared();
+        }
+
+        Shared(const Shared &) = delete;
+
+        Shared &operator=(const Shared &) = delete;
+
+    private:
+        StructureLock &lock;
+    };
+
+    void lockShared() {
+        for (;;) {
+            readers.fetch_add(1);
+            if (!writer.load()) {
+                return;
+            }
+            //step back for the writer
+            unlockShared();
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] { return !writer.load(); });
+        }
+    }
+
+    void unlockShared() {
+        if (readers.fetch_sub(1) == 1 && writer.load()) {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_all();
+        }
+    }
+
+    void lock() {
+        mtxWriter.lock();
+        writer.store(true);
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return readers.load() == 0; });
+    }
+
+    void unlock() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            writer.store(false);
+        }
+        cv.notify_all();
+        mtxWriter.unlock();
+    }
+
+private:
+    std::atomic<size_t> readers{0};
+    std::atomic<bool> writer{false};
+    //one writer at a time
+    std::mutex mtxWriter;
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+
+#endif //DCPLIB_STRUCTURELOCK_H
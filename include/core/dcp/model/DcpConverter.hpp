@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_DCPCONVERTER_HPP
+#define DCPLIB_DCPCONVERTER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#include <dcp/model/DcpTypes.hpp>
+#include <dcp/model/constant/DcpDataType.hpp>
+
+#if !defined(DCP_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DCP_CONVERTER_X86 1
+#include <immintrin.h>
+#define DCP_TARGET_SSE2 __attribute__((target("sse2")))
+#define DCP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DCP_CONVERTER_X86 0
+#endif
+
+/**
+ * Converts count elements from their wire representation at source into the memory layout at target.
+ * @param target Destination of the first element
+ * @param source Start of the first element in wire representation
+ * @param count Number of elements to convert
+ * @param targetBaseSize Size of one element at the destination
+ * @return Number of bytes consumed from source
+ */
+typedef size_t (*DcpConverter)(uint8_t *target, const uint8_t *source, size_t count, size_t targetBaseSize);
+
+/**
+ * Instruction set used by the conversion kernels. Ordered from least to most capable.
+ */
+enum class ConverterIsa : uint8_t {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+/**
+ * Scalar reference conversion. All vectorized kernels have to produce exactly the same result.
+ */
+template<typename T1, typename T2>
+inline size_t convertFixed(uint8_t *target, const uint8_t *source, size_t count, size_t targetBaseSize) {
+    for (size_t i = 0; i < count; i++) {
+        *((T1 *) (target + i * targetBaseSize)) = *((T2 *) (source + i * sizeof(T2)));
+    }
+    return count * sizeof(T2);
+}
+
+template<typename T>
+inline size_t copyFixed(uint8_t *target, const uint8_t *source, size_t count, size_t /*targetBaseSize*/) {
+    std::memcpy(target, source, count * sizeof(T));
+    return count * sizeof(T);
+}
+
+inline size_t copyVariable(uint8_t *target, const uint8_t *source, size_t count, size_t targetBaseSize) {
+    size_t offset = 0;
+    size_t otherOffset = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t &length = *((uint32_t *) (target + offset));
+        const uint32_t &newLength = *((const uint32_t *) (source + otherOffset));
+        length = newLength;
+        std::memcpy(target + (offset + 4), source + (otherOffset + 4), newLength);
+        offset += targetBaseSize;
+        otherOffset += (newLength + 4);
+    }
+    return otherOffset;
+}
+
+inline size_t serializeVariable(uint8_t *output, const uint8_t *source, size_t count, size_t sourceBaseSize) {
+    size_t offset = 0;
+    size_t otherOffset = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t &length = *((const uint32_t *) (source + offset));
+        uint32_t &outLength = *((uint32_t *) (output + otherOffset));
+        outLength = length;
+        std::memcpy(output + (otherOffset + 4), source + (offset + 4), outLength);
+        offset += sourceBaseSize;
+        otherOffset += (outLength + 4);
+    }
+    return otherOffset;
+}
+
+/**
+ * Number of bytes serializeVariable writes for the same arguments
+ */
+inline size_t serializedVariableSize(const uint8_t *source, size_t count, size_t sourceBaseSize) {
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        size += *((const uint32_t *) (source + i * sourceBaseSize)) + 4;
+    }
+    return size;
+}
+
+inline size_t convertNothing(uint8_t * /*target*/, const uint8_t * /*source*/, size_t /*count*/, size_t /*targetBaseSize*/) {
+    return 0;
+}
+
+#if DCP_CONVERTER_X86
+
+/*
+ * Widening kernels. Every source type except uint32 and float32 is first widened to 32 bit signed
+ * lanes, which is lossless as only widening pairs are allowed, and then stored in the target type.
+ * uint32 and float32 sources are handled by dedicated block conversions.
+ */
+namespace converter {
+    namespace sse2 {
+        // load 4 elements into 32 bit lanes
+
+        DCP_TARGET_SSE2 inline __m128i load(const int8_t *source) {
+            int32_t raw;
+            std::memcpy(&raw, source, 4);
+            __m128i x = _mm_cvtsi32_si128(raw);
+            x = _mm_unpacklo_epi8(x, x);
+            x = _mm_unpacklo_epi16(x, x);
+            return _mm_srai_epi32(x, 24);
+        }
+
+        DCP_TARGET_SSE2 inline __m128i load(const uint8_t *source) {
+            int32_t raw;
+            std::memcpy(&raw, source, 4);
+            const __m128i zero = _mm_setzero_si128();
+            __m128i x = _mm_cvtsi32_si128(raw);
+            x = _mm_unpacklo_epi8(x, zero);
+            return _mm_unpacklo_epi16(x, zero);
+        }
+
+        DCP_TARGET_SSE2 inline __m128i load(const int16_t *source) {
+            __m128i x = _mm_loadl_epi64((const __m128i *) source);
+            x = _mm_unpacklo_epi16(x, x);
+            return _mm_srai_epi32(x, 16);
+        }
+
+        DCP_TARGET_SSE2 inline __m128i load(const uint16_t *source) {
+            __m128i x = _mm_loadl_epi64((const __m128i *) source);
+            return _mm_unpacklo_epi16(x, _mm_setzero_si128());
+        }
+
+        DCP_TARGET_SSE2 inline __m128i load(const int32_t *source) {
+            return _mm_loadu_si128((const __m128i *) source);
+        }
+
+        // store 4 elements from 32 bit lanes
+
+        DCP_TARGET_SSE2 inline void store(int16_t *target, __m128i x) {
+            _mm_storel_epi64((__m128i *) target, _mm_packs_epi32(x, x));
+        }
+
+        DCP_TARGET_SSE2 inline void store(uint16_t *target, __m128i x) {
+            _mm_storel_epi64((__m128i *) target, _mm_packs_epi32(x, x));
+        }
+
+        DCP_TARGET_SSE2 inline void store(int32_t *target, __m128i x) {
+            _mm_storeu_si128((__m128i *) target, x);
+        }
+
+        DCP_TARGET_SSE2 inline void store(uint32_t *target, __m128i x) {
+            _mm_storeu_si128((__m128i *) target, x);
+        }
+
+        DCP_TARGET_SSE2 inline void store(int64_t *target, __m128i x) {
+            const __m128i sign = _mm_srai_epi32(x, 31);
+            _mm_storeu_si128((__m128i *) target, _mm_unpacklo_epi32(x, sign));
+            _mm_storeu_si128((__m128i *) (target + 2), _mm_unpackhi_epi32(x, sign));
+        }
+
+        DCP_TARGET_SSE2 inline void store(uint64_t *target, __m128i x) {
+            store((int64_t *) target, x);
+        }
+
+        DCP_TARGET_SSE2 inline void store(float32_t *target, __m128i x) {
+            _mm_storeu_ps(target, _mm_cvtepi32_ps(x));
+        }
+
+        DCP_TARGET_SSE2 inline void store(float64_t *target, __m128i x) {
+            _mm_storeu_pd(target, _mm_cvtepi32_pd(x));
+            _mm_storeu_pd(target + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(x, x)));
+        }
+
+        template<typename T1, typename T2>
+        DCP_TARGET_SSE2 inline void convertBlock(T1 *target, const T2 *source) {
+            store(target, load(source));
+        }
+
+        DCP_TARGET_SSE2 inline void convertBlock(uint64_t *target, const uint32_t *source) {
+            const __m128i x = _mm_loadu_si128((const __m128i *) source);
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128((__m128i *) target, _mm_unpacklo_epi32(x, zero));
+            _mm_storeu_si128((__m128i *) (target + 2), _mm_unpackhi_epi32(x, zero));
+        }
+
+        DCP_TARGET_SSE2 inline void convertBlock(int64_t *target, const uint32_t *source) {
+            convertBlock((uint64_t *) target, source);
+        }
+
+        DCP_TARGET_SSE2 inline void convertBlock(float64_t *target, const uint32_t *source) {
+            // shift into the int32 range, convert exactly and shift back
+            __m128i x = _mm_loadu_si128((const __m128i *) source);
+            x = _mm_xor_si128(x, _mm_set1_epi32((int32_t) 0x80000000));
+            const __m128d offset = _mm_set1_pd(2147483648.0);
+            _mm_storeu_pd(target, _mm_add_pd(_mm_cvtepi32_pd(x), offset));
+            _mm_storeu_pd(target + 2, _mm_add_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(x, x)), offset));
+        }
+
+        DCP_TARGET_SSE2 inline void convertBlock(float64_t *target, const float32_t *source) {
+            const __m128 x = _mm_loadu_ps(source);
+            _mm_storeu_pd(target, _mm_cvtps_pd(x));
+            _mm_storeu_pd(target + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+        }
+
+        template<typename T1, typename T2>
+        DCP_TARGET_SSE2 size_t convert(uint8_t *target, const uint8_t *source, size_t count, size_t /*targetBaseSize*/) {
+            T1 *out = (T1 *) target;
+            const T2 *in = (const T2 *) source;
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                convertBlock(out + i, in + i);
+            }
+            convertFixed<T1, T2>(target + i * sizeof(T1), source + i * sizeof(T2), count - i, sizeof(T1));
+            return count * sizeof(T2);
+        }
+    }
+
+    namespace avx2 {
+        // load 8 elements into 32 bit lanes
+
+        DCP_TARGET_AVX2 inline __m256i load(const int8_t *source) {
+            return _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *) source));
+        }
+
+        DCP_TARGET_AVX2 inline __m256i load(const uint8_t *source) {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) source));
+        }
+
+        DCP_TARGET_AVX2 inline __m256i load(const int16_t *source) {
+            return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) source));
+        }
+
+        DCP_TARGET_AVX2 inline __m256i load(const uint16_t *source) {
+            return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) source));
+        }
+
+        DCP_TARGET_AVX2 inline __m256i load(const int32_t *source) {
+            return _mm256_loadu_si256((const __m256i *) source);
+        }
+
+        // store 8 elements from 32 bit lanes
+
+        DCP_TARGET_AVX2 inline void store(int16_t *target, __m256i x) {
+            const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+            _mm_storeu_si128((__m128i *) target, packed);
+        }
+
+        DCP_TARGET_AVX2 inline void store(uint16_t *target, __m256i x) {
+            store((int16_t *) target, x);
+        }
+
+        DCP_TARGET_AVX2 inline void store(int32_t *target, __m256i x) {
+            _mm256_storeu_si256((__m256i *) target, x);
+        }
+
+        DCP_TARGET_AVX2 inline void store(uint32_t *target, __m256i x) {
+            _mm256_storeu_si256((__m256i *) target, x);
+        }
+
+        DCP_TARGET_AVX2 inline void store(int64_t *target, __m256i x) {
+            _mm256_storeu_si256((__m256i *) target, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+            _mm256_storeu_si256((__m256i *) (target + 4), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+        }
+
+        DCP_TARGET_AVX2 inline void store(uint64_t *target, __m256i x) {
+            store((int64_t *) target, x);
+        }
+
+        DCP_TARGET_AVX2 inline void store(float32_t *target, __m256i x) {
+            _mm256_storeu_ps(target, _mm256_cvtepi32_ps(x));
+        }
+
+        DCP_TARGET_AVX2 inline void store(float64_t *target, __m256i x) {
+            _mm256_storeu_pd(target, _mm256_cvtepi32_pd(_mm256_castsi256_si128(x)));
+            _mm256_storeu_pd(target + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)));
+        }
+
+        template<typename T1, typename T2>
+        DCP_TARGET_AVX2 inline void convertBlock(T1 *target, const T2 *source) {
+            store(target, load(source));
+        }
+
+        DCP_TARGET_AVX2 inline void convertBlock(uint64_t *target, const uint32_t *source) {
+            _mm256_storeu_si256((__m256i *) target, _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) source)));
+            _mm256_storeu_si256((__m256i *) (target + 4),
+                                _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (source + 4))));
+        }
+
+        DCP_TARGET_AVX2 inline void convertBlock(int64_t *target, const uint32_t *source) {
+            convertBlock((uint64_t *) target, source);
+        }
+
+        DCP_TARGET_AVX2 inline void convertBlock(float64_t *target, const uint32_t *source) {
+            // shift into the int32 range, convert exactly and shift back
+            const __m128i sign = _mm_set1_epi32((int32_t) 0x80000000);
+            const __m256d offset = _mm256_set1_pd(2147483648.0);
+            const __m128i lo = _mm_xor_si128(_mm_loadu_si128((const __m128i *) source), sign);
+            const __m128i hi = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (source + 4)), sign);
+            _mm256_storeu_pd(target, _mm256_add_pd(_mm256_cvtepi32_pd(lo), offset));
+            _mm256_storeu_pd(target + 4, _mm256_add_pd(_mm256_cvtepi32_pd(hi), offset));
+        }
+
+        DCP_TARGET_AVX2 inline void convertBlock(float64_t *target, const float32_t *source) {
+            _mm256_storeu_pd(target, _mm256_cvtps_pd(_mm_loadu_ps(source)));
+            _mm256_storeu_pd(target + 4, _mm256_cvtps_pd(_mm_loadu_ps(source + 4)));
+        }
+
+        template<typename T1, typename T2>
+        DCP_TARGET_AVX2 size_t convert(uint8_t *target, const uint8_t *source, size_t count, size_t /*targetBaseSize*/) {
+            T1 *out = (T1 *) target;
+            const T2 *in = (const T2 *) source;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                convertBlock(out + i, in + i);
+            }
+            convertFixed<T1, T2>(target + i * sizeof(T1), source + i * sizeof(T2), count - i, sizeof(T1));
+            return count * sizeof(T2);
+        }
+    }
+}
+
+#endif
+
+/**
+ * Get the most capable instruction set supported by the executing cpu.
+ * @return Instruction set of the conversion kernels
+ */
+inline ConverterIsa getSupportedConverterIsa() {
+#if DCP_CONVERTER_X86
+    static const ConverterIsa supported = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return ConverterIsa::AVX2;
+        } else if (__builtin_cpu_supports("sse2")) {
+            return ConverterIsa::SSE2;
+        }
+        return ConverterIsa::SCALAR;
+    }();
+    return supported;
+#else
+    return ConverterIsa::SCALAR;
+#endif
+}
+
+template<typename T1, typename T2>
+inline DcpConverter selectConverter(ConverterIsa isa) {
+#if DCP_CONVERTER_X86
+    switch (isa) {
+        case ConverterIsa::AVX2:
+            return &converter::avx2::convert<T1, T2>;
+        case ConverterIsa::SSE2:
+            return &converter::sse2::convert<T1, T2>;
+        default:
+            break;
+    }
+#else
+    (void) isa;
+#endif
+    return &convertFixed<T1, T2>;
+}
+
+#define CASE_CONVERT(val, T1, T2) \
+        case DcpDataType::val : \
+            return selectConverter<T1, T2>(isa);
+
+#define CASE_COPY(val, T) \
+        case DcpDataType::val : \
+            return &copyFixed<T>;
+
+#define INNER_SWITCH_START switch(sourceDataType){
+#define INNER_SWITCH_END \
+        default: \
+            return &convertNothing; \
+    }
+
+/**
+ * Look up the converter for a pair of data types. Pairs which are not allowed for input assignments
+ * result in a converter which does nothing. Identical types are copied with memcpy, widening pairs
+ * use the vectorized kernels of the given instruction set.
+ * @param dataType Data type of the destination
+ * @param sourceDataType Data type of the wire representation
+ * @param isa Instruction set to use, limited to the one supported by the executing cpu
+ * @return Converter from sourceDataType to dataType
+ */
+inline DcpConverter getConverter(DcpDataType dataType, DcpDataType sourceDataType,
+                                 ConverterIsa isa = ConverterIsa::AVX2) {
+    if (isa > getSupportedConverterIsa()) {
+        isa = getSupportedConverterIsa();
+    }
+    switch (dataType) {
+        case DcpDataType::uint8:
+            INNER_SWITCH_START //
+                CASE_COPY(uint8, uint8_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::uint16:
+            INNER_SWITCH_START //
+                CASE_CONVERT(uint8, uint16_t, uint8_t)
+                CASE_COPY(uint16, uint16_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::uint32:
+            INNER_SWITCH_START //
+                CASE_CONVERT(uint8, uint32_t, uint8_t)
+                CASE_CONVERT(uint16, uint32_t, uint16_t)
+                CASE_COPY(uint32, uint32_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::uint64:
+            INNER_SWITCH_START //
+                CASE_CONVERT(uint8, uint64_t, uint8_t)
+                CASE_CONVERT(uint16, uint64_t, uint16_t)
+                CASE_CONVERT(uint32, uint64_t, uint32_t)
+                CASE_COPY(uint64, uint64_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::int8:
+            INNER_SWITCH_START //
+                CASE_COPY(int8, int8_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::int16:
+            INNER_SWITCH_START //
+                CASE_CONVERT(int8, int16_t, int8_t)
+                CASE_COPY(int16, int16_t)
+                CASE_CONVERT(uint8, int16_t, uint8_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::int32:
+            INNER_SWITCH_START //
+                CASE_CONVERT(int8, int32_t, int8_t)
+                CASE_CONVERT(int16, int32_t, int16_t)
+                CASE_COPY(int32, int32_t)
+                CASE_CONVERT(uint8, int32_t, uint8_t)
+                CASE_CONVERT(uint16, int32_t, uint16_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::int64:
+            INNER_SWITCH_START //
+                CASE_CONVERT(int8, int64_t, int8_t)
+                CASE_CONVERT(int16, int64_t, int16_t)
+                CASE_CONVERT(int32, int64_t, int32_t)
+                CASE_COPY(int64, int64_t)
+                CASE_CONVERT(uint8, int64_t, uint8_t)
+                CASE_CONVERT(uint16, int64_t, uint16_t)
+                CASE_CONVERT(uint32, int64_t, uint32_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::float32:
+            INNER_SWITCH_START //
+                CASE_CONVERT(int8, float32_t, int8_t)
+                CASE_CONVERT(int16, float32_t, int16_t)
+                CASE_CONVERT(uint8, float32_t, uint8_t)
+                CASE_CONVERT(uint16, float32_t, uint16_t)
+                CASE_COPY(float32, float32_t)
+        INNER_SWITCH_END
+
+        case DcpDataType::float64:
+            INNER_SWITCH_START //
+                CASE_CONVERT(int8, float64_t, int8_t)
+                CASE_CONVERT(int16, float64_t, int16_t)
+                CASE_CONVERT(int32, float64_t, int32_t)
+                CASE_CONVERT(uint8, float64_t, uint8_t)
+                CASE_CONVERT(uint16, float64_t, uint16_t)
+                CASE_CONVERT(uint32, float64_t, uint32_t)
+                CASE_CONVERT(float32, float64_t, float32_t)
+                CASE_COPY(float64, float64_t)
+        INNER_SWITCH_END
+        case DcpDataType::binary:
+        case DcpDataType::string:
+            return &copyVariable;
+        default:
+            return &convertNothing;
+    }
+}
+
+#undef CASE_CONVERT
+#undef CASE_COPY
+#undef INNER_SWITCH_START
+#undef INNER_SWITCH_END
+#undef DCP_TARGET_SSE2
+#undef DCP_TARGET_AVX2
+#undef DCP_CONVERTER_X86
+
+#endif //DCPLIB_DCPCONVERTER_HPP
@@ -11,13 +11,24 @@
 #define ACOSAR_DCPLOGENTRY_H
 
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <regex>
 #include <string>
+#include <vector>
 #include <iomanip>
 #include <sstream>
+#include <streambuf>
+#include <ostream>
 #include <dcp/model/LogTemplate.hpp>
 #include <dcp/model/DcpTypes.hpp>
+#include <dcp/model/constant/DcpError.hpp>
+#include <dcp/model/constant/DcpLogMode.hpp>
+#include <dcp/model/constant/DcpOpMode.hpp>
+#include <dcp/model/constant/DcpPduType.hpp>
+#include <dcp/model/constant/DcpScope.hpp>
 #include <dcp/model/constant/DcpState.hpp>
+#include <dcp/model/constant/DcpTransportProtocol.hpp>
 
 class LogEntry {
 public:
@@ -35,109 +46,35 @@ public:
     }
 
     size_t applyPayloadToString() {
-        size_t offset = 9;
-        msg = std::string(logTemplate.msg);
-        for (DcpDataType type : logTemplate.dataTypes) {
-            std::string value;
-            switch (type) {
-                case DcpDataType::int8: {
-                    value = std::to_string((int) *((int8_t *) (payload + offset)));
-                    offset += 1;
-                    break;
-                }
-                case DcpDataType::int16: {
-                    value = std::to_string(*((int16_t *) (payload + offset)));
-                    offset += 2;
-                    break;
-
-                }
-                case DcpDataType::int32: {
-                    value = std::to_string(*((int32_t *) (payload + offset)));
-                    offset += 4;
-                    break;
-
-                }
-                case DcpDataType::int64: {
-                    value = std::to_string(*((int64_t *) (payload + offset)));
-                    offset += 8;
-                    break;
-
-                }
-                case DcpDataType::uint8: {
-                    value = std::to_string((int) *((uint8_t *) (payload + offset)));
-                    offset += 1;
-                    break;
-
-                }
-                case DcpDataType::uint16: {
-                    value = std::to_string(*((uint16_t *) (payload + offset)));
-                    offset += 2;
-                    break;
-
-                }
-                case DcpDataType::uint32: {
-                    value = std::to_string(*((uint32_t *) (payload + offset)));
-                    offset += 4;
-                    break;
-
-                }
-                case DcpDataType::uint64: {
-                    value = std::to_string(*((uint64_t *) (payload + offset)));
-                    offset += 8;
-                    break;
-
-                }
-                case DcpDataType::float32: {
-                    std::stringstream stream;
-                    stream << *((float32_t *) (payload + offset));
-                    value = stream.str();
-                    offset += 4;
-                    break;
-
-                }
-                case DcpDataType::float64: {
-                    std::stringstream stream;
-                    stream << *((float64_t *) (payload + offset));
-                    value = stream.str();
-                    offset += 8;
-                    break;
-
-                }
-                case DcpDataType::binary: {
-                    std::stringstream hs;
-                    size_t length = *((int16_t *) (payload + offset));
-                    for (size_t i = 0; i < length; ++i)
-                        hs << std::hex << std::setw(2) << std::setfill('0')
-                           << (int) *(payload + (offset + 2 + i)) << " ";
-                    value = hs.str();
-                    offset += (length + 2);
-                    break;
+        msg.clear();
+        msg.reserve(logTemplate.msg.size() + 16 * logTemplate.dataTypes.size());
+        this->size = render(msg);
+        this->msgGenerated = true;
+        return this->size;
+    }
 
-                }
-                case DcpDataType::string: {
-                    size_t length = *((int16_t *) (payload + offset));
-                    value = std::string((char *) (payload + (offset + 2)), length);
-                    offset += (length + 2);
-                    break;
+    /**
+     * Append the message with the values of the payload to out, in one pass over the segments of the template.
+     * Reusing out avoids allocations once its capacity suffices.
+     * @return Size of the payload
+     */
+    size_t render(std::string &out) const {
+        //offsets of the arguments in the payload, the segments may use them in a different order
+        static thread_local std::vector<size_t> offsets;
+        offsets.resize(logTemplate.dataTypes.size());
+        size_t offset = 9;
+        for (size_t i = 0; i < logTemplate.dataTypes.size(); i++) {
+            offsets[i] = offset;
+            offset += fieldSize(logTemplate.dataTypes[i], payload + offset);
+        }
 
-                }
-                case DcpDataType::state: {
-                    value = to_string(*((DcpState*) (payload + offset)));
-                    offset += 1;
-                    break;
-                }
+        const char *text = logTemplate.msg.data();
+        for (const LogTemplate::Segment &segment : logTemplate.segments) {
+            out.append(text + segment.literalStart, segment.literalLength);
+            if (segment.argument >= 0) {
+                appendField(out, logTemplate.dataTypes[segment.argument], payload + offsets[segment.argument]);
             }
-
-
-            std::string typeStr = "%" + to_string(type);
-            const size_t pos = msg.find(typeStr);
-            msg.replace(pos, typeStr.length(), value);
-
         }
-        std::stringstream hs;
-
-        this->size = offset;
-        this->msgGenerated = true;
         return offset;
     }
 
@@ -173,6 +110,10 @@ public:
         return logTemplate.level;
     }
 
+    const LogTemplate &getLogTemplate() const {
+        return logTemplate;
+    }
+
     uint8_t *serialize() const {
         return payload;
     }
@@ -190,6 +131,166 @@ public:
 
 
 private:
+    template<typename T>
+    static inline T read(const uint8_t *field) {
+        T value;
+        std::memcpy(&value, field, sizeof(T));
+        return value;
+    }
+
+    static size_t fieldSize(DcpDataType type, const uint8_t *field) {
+        switch (type) {
+            case DcpDataType::uint16:
+            case DcpDataType::int16:
+            case DcpDataType::error:
+                return 2;
+            case DcpDataType::uint32:
+            case DcpDataType::int32:
+            case DcpDataType::float32:
+                return 4;
+            case DcpDataType::uint64:
+            case DcpDataType::int64:
+            case DcpDataType::float64:
+                return 8;
+            case DcpDataType::string:
+            case DcpDataType::binary:
+                return 2 + read<uint16_t>(field);
+            default:
+                return 1;
+        }
+    }
+
+    static void appendUnsigned(std::string &out, uint64_t value) {
+        char digits[20];
+        char *end = digits + sizeof(digits);
+        char *begin = end;
+        do {
+            *--begin = (char) ('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        out.append(begin, end);
+    }
+
+    static void appendSigned(std::string &out, int64_t value) {
+        if (value < 0) {
+            out.push_back('-');
+            appendUnsigned(out, 0 - (uint64_t) value);
+        } else {
+            appendUnsigned(out, (uint64_t) value);
+        }
+    }
+
+    static void appendFloat(std::string &out, double value) {
+        //%g matches the default formatting of streams
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%g", value);
+        out.append(buffer, length);
+    }
+
+    /**
+     * Stream buffer appending to a string. Enumerations are written with their operator<< without a stringstream.
+     */
+    class AppendBuffer : public std::streambuf {
+    public:
+        std::string *out = nullptr;
+
+    protected:
+        int_type overflow(int_type c) override {
+            if (c != traits_type::eof()) {
+                out->push_back((char) c);
+            }
+            return c;
+        }
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override {
+            out->append(s, (size_t) n);
+            return n;
+        }
+    };
+
+    template<typename T>
+    static void appendStreamed(std::string &out, T value) {
+        static thread_local AppendBuffer buffer;
+        static thread_local std::ostream stream(&buffer);
+        buffer.out = &out;
+        stream << value;
+    }
+
+    static void appendField(std::string &out, DcpDataType type, const uint8_t *field) {
+        switch (type) {
+            case DcpDataType::uint8:
+                appendUnsigned(out, read<uint8_t>(field));
+                break;
+            case DcpDataType::uint16:
+                appendUnsigned(out, read<uint16_t>(field));
+                break;
+            case DcpDataType::uint32:
+                appendUnsigned(out, read<uint32_t>(field));
+                break;
+            case DcpDataType::uint64:
+                appendUnsigned(out, read<uint64_t>(field));
+                break;
+            case DcpDataType::int8:
+                appendSigned(out, read<int8_t>(field));
+                break;
+            case DcpDataType::int16:
+                appendSigned(out, read<int16_t>(field));
+                break;
+            case DcpDataType::int32:
+                appendSigned(out, read<int32_t>(field));
+                break;
+            case DcpDataType::int64:
+                appendSigned(out, read<int64_t>(field));
+                break;
+            case DcpDataType::float32:
+                appendFloat(out, read<float32_t>(field));
+                break;
+            case DcpDataType::float64:
+                appendFloat(out, read<float64_t>(field));
+                break;
+            case DcpDataType::string:
+                out.append((const char *) field + 2, read<uint16_t>(field));
+                break;
+            case DcpDataType::binary: {
+                static const char hex[] = "0123456789abcdef";
+                const uint16_t length = read<uint16_t>(field);
+                for (size_t i = 0; i < length; ++i) {
+                    out.push_back(hex[field[2 + i] >> 4]);
+                    out.push_back(hex[field[2 + i] & 0xF]);
+                    out.push_back(' ');
+                }
+                break;
+            }
+            case DcpDataType::state:
+                appendStreamed(out, read<DcpState>(field));
+                break;
+            case DcpDataType::opMode:
+                appendStreamed(out, read<DcpOpMode>(field));
+                break;
+            case DcpDataType::dataType:
+                appendStreamed(out, read<DcpDataType>(field));
+                break;
+            case DcpDataType::error:
+                appendStreamed(out, read<DcpError>(field));
+                break;
+            case DcpDataType::scope:
+                appendStreamed(out, read<DcpScope>(field));
+                break;
+            case DcpDataType::transportProtocol:
+                appendStreamed(out, read<DcpTransportProtocol>(field));
+                break;
+            case DcpDataType::logMode:
+                appendStreamed(out, read<DcpLogMode>(field));
+                break;
+            case DcpDataType::logLevel:
+                appendStreamed(out, read<DcpLogLevel>(field));
+                break;
+            case DcpDataType::pduType:
+                appendStreamed(out, read<DcpPduType>(field));
+                break;
+        }
+    }
+
     const LogTemplate &logTemplate;
     uint8_t *payload;
     size_t size;
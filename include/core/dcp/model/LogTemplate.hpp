@@ -10,6 +10,7 @@
 #ifndef ACOSAR_LOGTEMPLATE_H
 #define ACOSAR_LOGTEMPLATE_H
 
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include <vector>
@@ -27,22 +28,159 @@ enum LogCategory : uint8_t {
 
 };
 
+/**
+ * Name of the placeholder of a data type in a log message, without the leading %.
+ */
+static inline const char *logPlaceholder(DcpDataType type) {
+    switch (type) {
+        case DcpDataType::uint8:
+            return "uint8";
+        case DcpDataType::uint16:
+            return "uint16";
+        case DcpDataType::uint32:
+            return "uint32";
+        case DcpDataType::uint64:
+            return "uint64";
+        case DcpDataType::int8:
+            return "int8";
+        case DcpDataType::int16:
+            return "int16";
+        case DcpDataType::int32:
+            return "int32";
+        case DcpDataType::int64:
+            return "int64";
+        case DcpDataType::float32:
+            return "float32";
+        case DcpDataType::float64:
+            return "float64";
+        case DcpDataType::string:
+            return "string";
+        case DcpDataType::binary:
+            return "binary";
+        case DcpDataType::error:
+            return "uint16";
+        default:
+            //internal enumerations are logged as uint8
+            return "uint8";
+    }
+}
+
 class LogTemplate {
 
 
 public:
+    /**
+     * Part of a message: literal text followed by the placeholder of an argument.
+     */
+    struct Segment {
+        size_t literalStart;
+        size_t literalLength;
+        //index in dataTypes, -1 for the text after the last placeholder
+        int argument;
+    };
+
     LogTemplate(uint8_t id, uint8_t category, DcpLogLevel level, const std::string &msg,
                 const std::vector<DcpDataType> &dataTypes) : id(id), category(category), level(level), msg(msg),
-                                                             dataTypes(dataTypes) {}
+                                                             dataTypes(dataTypes), segments(parse(msg, dataTypes)) {}
     ~LogTemplate(){}
     const uint8_t id;
     const uint8_t category;
     const DcpLogLevel level;
     const std::string msg;
     const std::vector<DcpDataType> dataTypes;
+    //msg split at the placeholders, in order of appearance
+    const std::vector<Segment> segments;
+
+private:
+    /**
+     * Each argument takes the first unused placeholder of its data type. Arguments without a placeholder are not
+     * shown.
+     */
+    static std::vector<Segment> parse(const std::string &msg, const std::vector<DcpDataType> &dataTypes) {
+        struct Placeholder {
+            size_t position;
+            size_t length;
+            int argument;
+        };
+        std::vector<Placeholder> placeholders;
+        for (size_t i = 0; i < dataTypes.size(); i++) {
+            const std::string needle = std::string("%") + logPlaceholder(dataTypes[i]);
+            size_t position = msg.find(needle);
+            while (position != std::string::npos &&
+                   std::any_of(placeholders.begin(), placeholders.end(), [position](const Placeholder &used) {
+                       return used.position == position;
+                   })) {
+                position = msg.find(needle, position + 1);
+            }
+            if (position != std::string::npos) {
+                placeholders.push_back({position, needle.length(), (int) i});
+            }
+        }
+        std::sort(placeholders.begin(), placeholders.end(), [](const Placeholder &a, const Placeholder &b) {
+            return a.position < b.position;
+        });
+
+        std::vector<Segment> segments;
+        size_t start = 0;
+        for (const Placeholder &placeholder : placeholders) {
+            segments.push_back({start, placeholder.position - start, placeholder.argument});
+            start = placeholder.position + placeholder.length;
+        }
+        segments.push_back({start, msg.size() - start, -1});
+        return segments;
+    }
 };
 
 static uint8_t logId = 1;
 
+#ifndef DCP_MIN_LOG_LEVEL
+//Log calls with a less severe level are removed at compile time
+#define DCP_MIN_LOG_LEVEL DcpLogLevel::LVL_DEBUG
+#endif
+#ifndef DCP_MIN_LOG_LEVEL_ETHERNET
+#define DCP_MIN_LOG_LEVEL_ETHERNET DCP_MIN_LOG_LEVEL
+#endif
+#ifndef DCP_MIN_LOG_LEVEL_SLAVE
+#define DCP_MIN_LOG_LEVEL_SLAVE DCP_MIN_LOG_LEVEL
+#endif
+#ifndef DCP_MIN_LOG_LEVEL_MASTER
+#define DCP_MIN_LOG_LEVEL_MASTER DCP_MIN_LOG_LEVEL
+#endif
+
+/**
+ * Least severe level of a log category that is compiled in. Specialize it to set the level of own categories.
+ */
+template<uint8_t Category>
+struct MinLogLevel {
+    static constexpr DcpLogLevel value = DCP_MIN_LOG_LEVEL;
+};
+
+template<>
+struct MinLogLevel<LogCategory::DCP_LIB_ETHERNET> {
+    static constexpr DcpLogLevel value = DCP_MIN_LOG_LEVEL_ETHERNET;
+};
+
+template<>
+struct MinLogLevel<LogCategory::DCP_LIB_SLAVE> {
+    static constexpr DcpLogLevel value = DCP_MIN_LOG_LEVEL_SLAVE;
+};
+
+template<>
+struct MinLogLevel<LogCategory::DCP_LIB_MASTER> {
+    static constexpr DcpLogLevel value = DCP_MIN_LOG_LEVEL_MASTER;
+};
+
+/**
+ * Log template with category, level and data types known at compile time. Log checks its arguments
+ * against the data types while compiling, calls below the MinLogLevel of the category compile to nothing.
+ */
+template<uint8_t Category, DcpLogLevel Level, DcpDataType... Types>
+class LogDescriptor : public LogTemplate {
+public:
+    static constexpr bool compiledIn = (uint8_t) Level <= (uint8_t) MinLogLevel<Category>::value;
+
+    LogDescriptor(uint8_t id, const std::string &msg) : LogTemplate(id, Category, Level, msg, {Types...}) {}
+};
+
 
 #endif //ACOSAR_LOGTEMPLATE_H
\ No newline at end of file
@@ -16,27 +16,9 @@
 #include <dcp/model/constant/DcpDataType.hpp>
 #include <dcp/model/DcpString.hpp>
 #include <dcp/model/DcpBinary.hpp>
+#include <dcp/model/DcpConverter.hpp>
 
 
-#define CAST(T1, T2)\
-    for(int i = 0; i < numberOfAssignments; i++){\
-        *((T1*)(payload + offset)) = *((T2*)(newPayload + (start + otherOffset)));\
-        offset += baseSize;\
-        otherOffset += otherBaseSize;\
-    }
-
-#define INNER_CASE_CAST(val, T1, T2) \
-		case DcpDataType::val : \
-		 	 CAST(T1, T2) \
-		 	 break;
-
-#define INNER_SWITCH_START switch(sourceDataType){
-#define INNER_SWITCH_END \
-        default: \
-        break;\
-    } \
-    break;
-
 class MultiDimValue{
 public:
     MultiDimValue(DcpDataType dataType, size_t baseSize, const std::vector<size_t> dimensions) : dataType(dataType),
@@ -48,10 +30,26 @@ public:
             numberOfAssignments *= dim;
         }
         payload = new uint8_t[numberOfAssignments * baseSize];
+        ownsPayload = true;
     }
 
     ~MultiDimValue(){
-        delete[] payload;
+        if(ownsPayload) {
+            delete[] payload;
+        }
+    }
+
+    /**
+     * Move the payload to memory owned by someone else, e. g. a ValueArena. The current content is copied.
+     * @param newPayload Memory of at least getSize() bytes, which has to outlive this value or the next relocation
+     */
+    void relocate(uint8_t* newPayload){
+        std::memcpy(newPayload, payload, getSize());
+        if(ownsPayload) {
+            delete[] payload;
+        }
+        payload = newPayload;
+        ownsPayload = false;
     }
 
     template<typename T>
@@ -61,126 +59,22 @@ public:
     }
 
     size_t update(const uint8_t* newPayload, size_t start, DcpDataType sourceDataType){
-        size_t offset = 0;
-        size_t otherOffset = 0;
-        size_t otherBaseSize = getDcpDataTypeSize(sourceDataType);
-        switch (dataType) {
-            case DcpDataType::uint8:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(uint8, uint8_t, uint8_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::uint16:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(uint8, uint16_t, uint8_t)
-                    INNER_CASE_CAST(uint16, uint16_t, uint16_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::uint32:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(uint8, uint32_t, uint8_t)
-                    INNER_CASE_CAST(uint16, uint32_t, uint16_t)
-                    INNER_CASE_CAST(uint32, uint32_t, uint32_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::uint64:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(uint8, uint64_t, uint8_t)
-                    INNER_CASE_CAST(uint16, uint64_t, uint16_t)
-                    INNER_CASE_CAST(uint32, uint64_t, uint32_t)
-                    INNER_CASE_CAST(uint64, uint64_t, uint64_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::int8:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, int8_t, int8_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::int16:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, int16_t, int8_t)
-                    INNER_CASE_CAST(int16, int16_t, int16_t)
-                    INNER_CASE_CAST(uint8, int16_t, uint8_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::int32:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, int32_t, int8_t)
-                    INNER_CASE_CAST(int16, int32_t, int16_t)
-                    INNER_CASE_CAST(int32, int32_t, int32_t)
-                    INNER_CASE_CAST(uint8, int32_t, uint8_t)
-                    INNER_CASE_CAST(uint16, int32_t, uint16_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::int64:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, int64_t, int8_t)
-                    INNER_CASE_CAST(int16, int64_t, int16_t)
-                    INNER_CASE_CAST(int32, int64_t, int32_t)
-                    INNER_CASE_CAST(int64, int64_t, int64_t)
-                    INNER_CASE_CAST(uint8, int64_t, uint8_t)
-                    INNER_CASE_CAST(uint16, int64_t, uint16_t)
-                    INNER_CASE_CAST(uint32, int64_t, uint32_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::float32:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, float32_t, int8_t)
-                    INNER_CASE_CAST(int16, float32_t, int16_t)
-                    INNER_CASE_CAST(uint8, float32_t, uint8_t)
-                    INNER_CASE_CAST(uint16, float32_t, uint16_t)
-                    INNER_CASE_CAST(float32, float32_t, float32_t)
-            INNER_SWITCH_END
-
-            case DcpDataType::float64:
-                INNER_SWITCH_START //
-                    INNER_CASE_CAST(int8, float64_t, int8_t)
-                    INNER_CASE_CAST(int16, float64_t, int16_t)
-                    INNER_CASE_CAST(int32, float64_t, int32_t)
-                    INNER_CASE_CAST(uint8, float64_t, uint8_t)
-                    INNER_CASE_CAST(uint16, float64_t, uint16_t)
-                    INNER_CASE_CAST(uint32, float64_t, uint32_t)
-                    INNER_CASE_CAST(float32, float64_t, float32_t)
-                    INNER_CASE_CAST(float64, float64_t, float64_t)
-            INNER_SWITCH_END
-            case DcpDataType::binary:
-            case DcpDataType::string:
-                for (int i = 0; i < numberOfAssignments; i++) {
-                        uint32_t& length = *((uint32_t*)(payload + offset));
-                        uint32_t& newLength = *((uint32_t*)(newPayload + (start + otherOffset)));
-                        length = newLength;
-                        std::memcpy(payload + (offset + 4), newPayload + (start + otherOffset + 4), newLength);
-                        offset += baseSize;
-                        otherOffset += (newLength + 4);
-                }
-                break;
-        }
-        return otherOffset;
+        return getConverter(dataType, sourceDataType)(payload, newPayload + start, numberOfAssignments, baseSize);
     }
 
     inline size_t serialize(uint8_t* output, size_t start){
-        size_t offset = 0;
-        size_t otherOffset = 0;
         switch(dataType){
             case DcpDataType::binary:
             case DcpDataType::string:
-                for (int i = 0; i < numberOfAssignments; i++) {
-                    uint32_t& length = *((uint32_t*)(payload + offset));
-                    uint32_t& outLength = *((uint32_t*)(output + (start + otherOffset)));
-                    outLength = length;
-                    std::memcpy(output + (start + otherOffset + 4), payload + (offset + 4), outLength);
-                    offset += baseSize;
-                    otherOffset += (outLength + 4);
-                }
-                break;
+                return serializeVariable(output + start, payload, numberOfAssignments, baseSize);
             default:
-                for (int i = 0; i < numberOfAssignments; i++) {
-                    std::memcpy(output + (start + otherOffset), payload + otherOffset, baseSize);
-                    otherOffset += baseSize;
-                }
-                break;
+                std::memcpy(output + start, payload, numberOfAssignments * baseSize);
+                return numberOfAssignments * baseSize;
         }
-        return otherOffset;
+    }
+
+    inline bool isFixedSize(){
+        return dataType != DcpDataType::binary && dataType != DcpDataType::string;
     }
 
     inline DcpDataType getDataType(){
@@ -195,6 +89,14 @@ public:
         return baseSize;
     }
 
+    inline size_t getNumberOfAssignments(){
+        return numberOfAssignments;
+    }
+
+    inline size_t getSize(){
+        return numberOfAssignments * baseSize;
+    }
+
     template<typename T>
     inline T getValue() {
         static_assert(std::is_pointer<T>::value, "Expected a pointer");
@@ -211,6 +113,7 @@ private:
     size_t baseSize;
     size_t numberOfAssignments;
     uint8_t* payload;
+    bool ownsPayload;
 
     std::vector<size_t> dimensions;
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_VALUEARENA_HPP
+#define DCPLIB_VALUEARENA_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * One cache line aligned block of memory holding the payloads of MultiDimValues.
+ * The arena does only own the memory, placing values is up to the caller.
+ */
+class ValueArena {
+public:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * Allocate a zero initialized block
+     * @param size Size of the block in bytes
+     */
+    explicit ValueArena(size_t size) : size(size) {
+        memory = new uint8_t[size + CACHE_LINE_SIZE];
+        block = memory + (CACHE_LINE_SIZE - ((uintptr_t) memory % CACHE_LINE_SIZE)) % CACHE_LINE_SIZE;
+        std::memset(block, 0, size);
+    }
+
+    ~ValueArena() {
+        delete[] memory;
+    }
+
+    ValueArena(const ValueArena &) = delete;
+
+    ValueArena &operator=(const ValueArena &) = delete;
+
+    inline uint8_t *getBlock() {
+        return block;
+    }
+
+    inline size_t getSize() {
+        return size;
+    }
+
+    /**
+     * Round an offset up to the next multiple of alignment
+     * @param offset Offset in bytes
+     * @param alignment Alignment in bytes, has to be a power of two
+     * @return Aligned offset
+     */
+    static inline size_t align(size_t offset, size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+private:
+    uint8_t *memory;
+    uint8_t *block;
+    size_t size;
+};
+
+#endif //DCPLIB_VALUEARENA_HPP
@@ -37,7 +37,33 @@
 #include <dcp/model/pdu/DcpPduStcRegister.hpp>
 #include <dcp/model/pdu/DcpPduStcRun.hpp>
 
-static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size) {
+#include <new>
+#include <type_traits>
+
+/**
+ * Storage for one PDU object. PDU classes only wrap the received stream and do not add members,
+ * so each of them fits in here.
+ */
+typedef std::aligned_storage<sizeof(DcpPdu), alignof(DcpPdu)>::type DcpPduStorage;
+
+template<typename T>
+static inline DcpPdu *constructDcpPdu(DcpPduStorage *storage, unsigned char *stream, size_t stream_size) {
+    static_assert(sizeof(T) <= sizeof(DcpPduStorage) && alignof(T) <= alignof(DcpPduStorage),
+                  "PDU class does not fit in DcpPduStorage");
+    if (storage == nullptr) {
+        return new T(stream, stream_size);
+    }
+    return new(storage) T(stream, stream_size);
+}
+
+/**
+ * Creates the PDU matching the type id in stream.
+ * @param stream byte array containing the received pdu, it is not copied
+ * @param stream_size number of bytes of the pdu, without the length indicator
+ * @param storage Storage to construct the PDU in. nullptr means the PDU is allocated on the heap
+ * @return PDU wrapping stream, it has to be deleted if storage is nullptr
+ */
+static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size, DcpPduStorage *storage) {
     DcpPduType &type_id = *((DcpPduType * )(stream + PDU_LENGTH_INDICATOR_SIZE));
     switch (type_id) {
         case DcpPduType::STC_configure:
@@ -47,62 +73,63 @@ static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size) {
         case DcpPduType::STC_deregister:
         case DcpPduType::STC_send_outputs:
         case DcpPduType::STC_prepare:
-            return new DcpPduStc(stream, stream_size);
+            return constructDcpPdu<DcpPduStc>(storage, stream, stream_size);
         case DcpPduType::STC_run:
-            return new DcpPduStcRun(stream, stream_size);
+            return constructDcpPdu<DcpPduStcRun>(storage, stream, stream_size);
         case DcpPduType::INF_state:
-            return new DcpPduBasic(stream, stream_size);
+            return constructDcpPdu<DcpPduBasic>(storage, stream, stream_size);
         case DcpPduType::INF_error:
-            return new DcpPduBasic(stream, stream_size);
+            return constructDcpPdu<DcpPduBasic>(storage, stream, stream_size);
         case DcpPduType::INF_log:
-            return new DcpPduInfLog(stream, stream_size);
+            return constructDcpPdu<DcpPduInfLog>(storage, stream, stream_size);
         case DcpPduType::NTF_state_changed:
-            return new DcpPduNtfStateChanged(stream, stream_size);
+            return constructDcpPdu<DcpPduNtfStateChanged>(storage, stream, stream_size);
         case DcpPduType::NTF_log:
-            return new DcpPduNtfLog(stream, stream_size);
+            return constructDcpPdu<DcpPduNtfLog>(storage, stream, stream_size);
         case DcpPduType::STC_do_step:
-            return new DcpPduStcDoStep(stream, stream_size);
+            return constructDcpPdu<DcpPduStcDoStep>(storage, stream, stream_size);
         case DcpPduType::CFG_time_res:
-            return new DcpPduCfgTimeRes(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgTimeRes>(storage, stream, stream_size);
         case DcpPduType::CFG_steps:
-            return new DcpPduCfgSteps(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgSteps>(storage, stream, stream_size);
         case DcpPduType::CFG_scope:
-            return new DcpPduCfgScope(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgScope>(storage, stream, stream_size);
         case DcpPduType::STC_register:
-            return new DcpPduStcRegister(stream, stream_size);
+            return constructDcpPdu<DcpPduStcRegister>(storage, stream, stream_size);
         case DcpPduType::CFG_input:
-            return new DcpPduCfgInput(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgInput>(storage, stream, stream_size);
         case DcpPduType::CFG_output:
-            return new DcpPduCfgOutput(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgOutput>(storage, stream, stream_size);
         case DcpPduType::CFG_clear:
-            return new DcpPduBasic(stream, stream_size);
+            return constructDcpPdu<DcpPduBasic>(storage, stream, stream_size);
         case DcpPduType::CFG_tunable_parameter:
-            return new DcpPduCfgTunableParameter(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgTunableParameter>(storage, stream, stream_size);
         case DcpPduType::CFG_parameter:
-            return new DcpPduCfgParameter(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgParameter>(storage, stream, stream_size);
         case DcpPduType::CFG_logging:
-            return new DcpPduCfgLogging(stream, stream_size);
+            return constructDcpPdu<DcpPduCfgLogging>(storage, stream, stream_size);
         case DcpPduType::DAT_input_output:
-            return new DcpPduDatInputOutput(stream, stream_size);
+            return constructDcpPdu<DcpPduDatInputOutput>(storage, stream, stream_size);
         case DcpPduType::DAT_parameter:
-            return new DcpPduDatParameter(stream, stream_size);
+            return constructDcpPdu<DcpPduDatParameter>(storage, stream, stream_size);
         case DcpPduType::RSP_ack:
-            return new DcpPduRspAck(stream, stream_size);
+            return constructDcpPdu<DcpPduRspAck>(storage, stream, stream_size);
         case DcpPduType::RSP_nack:
-            return new DcpPduRspNack(stream, stream_size);
+            return constructDcpPdu<DcpPduRspNack>(storage, stream, stream_size);
         case DcpPduType::RSP_error_ack:
-            return new DcpPduRspErrorAck(stream, stream_size);
+            return constructDcpPdu<DcpPduRspErrorAck>(storage, stream, stream_size);
         case DcpPduType::RSP_state_ack:
-            return new DcpPduRspStateAck(stream, stream_size);
+            return constructDcpPdu<DcpPduRspStateAck>(storage, stream, stream_size);
         case DcpPduType::RSP_log_ack:
-            return new DcpPduRspLogAck(stream, stream_size);
+            return constructDcpPdu<DcpPduRspLogAck>(storage, stream, stream_size);
         case DcpPduType::CFG_target_network_information: {
             DcpTransportProtocol &tp = *((DcpTransportProtocol * )(stream + 10));
             switch (tp) {
                 case DcpTransportProtocol::UDP_IPv4:
-                    return new DcpPduCfgNetworkInformationIPv4(stream, stream_size);
+                case DcpTransportProtocol::TCP_IPv4:
+                    return constructDcpPdu<DcpPduCfgNetworkInformationIPv4>(storage, stream, stream_size);
                 default:
-                    return new DcpPduCfgNetworkInformation(stream, stream_size);
+                    return constructDcpPdu<DcpPduCfgNetworkInformation>(storage, stream, stream_size);
             }
 
         }
@@ -110,9 +137,10 @@ static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size) {
             DcpTransportProtocol &tp = *((DcpTransportProtocol * )(stream + 10));
             switch (tp) {
                 case DcpTransportProtocol::UDP_IPv4:
-                    return new DcpPduCfgNetworkInformationIPv4(stream, stream_size);
+                case DcpTransportProtocol::TCP_IPv4:
+                    return constructDcpPdu<DcpPduCfgNetworkInformationIPv4>(storage, stream, stream_size);
                 default:
-                    return new DcpPduCfgNetworkInformation(stream, stream_size);
+                    return constructDcpPdu<DcpPduCfgNetworkInformation>(storage, stream, stream_size);
             }
 
         }
@@ -120,14 +148,59 @@ static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size) {
             DcpTransportProtocol &tp = *((DcpTransportProtocol * )(stream + 10));
             switch (tp) {
                 case DcpTransportProtocol::UDP_IPv4:
-                    return new DcpPduCfgParamNetworkInformationIPv4(stream, stream_size);
+                case DcpTransportProtocol::TCP_IPv4:
+                    return constructDcpPdu<DcpPduCfgParamNetworkInformationIPv4>(storage, stream, stream_size);
                 default:
-                    return new DcpPduCfgNetworkInformation(stream, stream_size);
+                    return constructDcpPdu<DcpPduCfgNetworkInformation>(storage, stream, stream_size);
             }
 
         }
     }
-    return new DcpPdu(stream, stream_size);
+    return constructDcpPdu<DcpPdu>(storage, stream, stream_size);
+}
+
+
+/**
+ * Creates the PDU matching the type id in stream on the heap.
+ * @param stream byte array containing the received pdu, it is not copied
+ * @param stream_size number of bytes of the pdu, without the length indicator
+ * @return PDU wrapping stream, it has to be deleted by the caller
+ */
+static DcpPdu *makeDcpPdu(unsigned char *stream, size_t stream_size) {
+    return makeDcpPdu(stream, stream_size, nullptr);
 }
 
+/**
+ * View of a received PDU, constructed in place without any heap allocation.
+ * It is only valid as long as the stream it wraps.
+ */
+class DcpPduView {
+public:
+    /**
+     * @param stream byte array containing the received pdu, it is not copied
+     * @param stream_size number of bytes of the pdu, without the length indicator
+     */
+    DcpPduView(unsigned char *stream, size_t stream_size) : pdu(makeDcpPdu(stream, stream_size, &storage)) {}
+
+    ~DcpPduView() {
+        pdu->~DcpPdu();
+    }
+
+    DcpPduView(const DcpPduView &) = delete;
+
+    DcpPduView &operator=(const DcpPduView &) = delete;
+
+    inline DcpPdu &operator*() {
+        return *pdu;
+    }
+
+    inline DcpPdu *operator->() {
+        return pdu;
+    }
+
+private:
+    DcpPduStorage storage;
+    DcpPdu *pdu;
+};
+
 #endif //DCPLIB_DCPPDUFACTORY_HPP
@@ -12,40 +12,29 @@
 
 #include <dcp/model/LogTemplate.hpp>
 
-static const LogTemplate NEW_SOCKET = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                           DcpLogLevel::LVL_DEBUG, "%string socket opened on %string",
-                                           {DcpDataType::string, DcpDataType::string});
-static const LogTemplate SOCKET_CLOSED = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                              DcpLogLevel::LVL_DEBUG, "%string socket closed on %string.",
-                                              {DcpDataType::string, DcpDataType::string});
-
-static const LogTemplate NEW_TCP_CONNECTION_IN = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                                 DcpLogLevel::LVL_DEBUG, "TCP connection established from %string.",
-                                                 {DcpDataType::string});
-
-static const LogTemplate NEW_TCP_CONNECTION_OUT = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                                          DcpLogLevel::LVL_DEBUG, "TCP connection established to %string.",
-                                                          {DcpDataType::string});
-
-static const LogTemplate TCP_CONNECTION_CLOSED = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                                      DcpLogLevel::LVL_DEBUG, "TCP connection with %string closed.",
-                                                      {DcpDataType::string});
-
-static const LogTemplate NEW_MASTER_ENDPOINT = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                                    DcpLogLevel::LVL_DEBUG,
-                                                    "%string endpoint for the master is now: %string.",
-                                                    {DcpDataType::string, DcpDataType::string});
-static const LogTemplate PDU_RECEIVED = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                             DcpLogLevel::LVL_DEBUG, "Pdu was received with content=%string",
-                                             {DcpDataType::string});
-static const LogTemplate PDU_SEND = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                         DcpLogLevel::LVL_DEBUG, "Pdu was send with content=%string",
-                                         {DcpDataType::string});
-
-static const LogTemplate NETWORK_PROBLEM = LogTemplate(logId++, LogCategory::DCP_LIB_ETHERNET,
-                                                         DcpLogLevel::LVL_ERROR,
-                                                         "Network problem in %string driver. Error Message: %string",
-                                                         {DcpDataType::string, DcpDataType::string});
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string, DcpDataType::string> NEW_SOCKET(logId++,
+                                           "%string socket opened on %string");
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string, DcpDataType::string> SOCKET_CLOSED(logId++,
+                                              "%string socket closed on %string.");
+
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string> NEW_TCP_CONNECTION_IN(logId++,
+                                                 "TCP connection established from %string.");
+
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string> NEW_TCP_CONNECTION_OUT(logId++,
+                                                          "TCP connection established to %string.");
+
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string> TCP_CONNECTION_CLOSED(logId++,
+                                                      "TCP connection with %string closed.");
+
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string, DcpDataType::string> NEW_MASTER_ENDPOINT(logId++,
+                                                    "%string endpoint for the master is now: %string.");
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string> PDU_RECEIVED(logId++,
+                                             "Pdu was received with content=%string");
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_DEBUG, DcpDataType::string> PDU_SEND(logId++,
+                                         "Pdu was send with content=%string");
+
+static const LogDescriptor<LogCategory::DCP_LIB_ETHERNET, DcpLogLevel::LVL_ERROR, DcpDataType::string, DcpDataType::string> NETWORK_PROBLEM(logId++,
+                                                         "Network problem in %string driver. Error Message: %string");
 
 
 #endif //DCPLIB_ERRORCODES_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_IOENGINE_HPP
+#define DCPLIB_IOENGINE_HPP
+
+#include <dcp/logic/DcpManager.hpp>
+#include <asio.hpp>
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Run an io_service on a number of threads until it is stopped. The calling thread is one of them.
+ * Handlers of one socket are kept in order by binding them to the strand of the socket.
+ * If a handler throws, the io_service is stopped and the first exception is rethrown on the calling thread.
+ * @param ios io_service to run
+ * @param threads Number of threads, at least one
+ */
+static void runIoService(asio::io_service &ios, size_t threads) {
+    asio::io_service::work work(ios);
+    std::exception_ptr failure;
+    std::mutex mtxFailure;
+    auto run = [&ios, &failure, &mtxFailure]() {
+        try {
+            ios.run();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mtxFailure);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            ios.stop();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back(run);
+    }
+    run();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+/**
+ * With more than one thread, control and DAT_parameter PDUs and errors are passed to the manager one at a time.
+ * DAT_input_output PDUs of different sockets are passed concurrently: the slave decodes them under a shared
+ * lock which only its structural rebuilds take exclusively, the master needs reserveSequenceIds before start().
+ * The mutex is recursive because a send failing while a PDU is handled reports the error on the same thread.
+ * @param manager Callbacks of the manager
+ * @param threads Number of threads running the io_service
+ * @return manager itself for one thread, otherwise callbacks which hold a common lock while calling manager
+ */
+static DcpManager serializeManager(const DcpManager &manager, size_t threads) {
+    if (threads <= 1) {
+        return manager;
+    }
+    std::shared_ptr<std::recursive_mutex> mtx = std::make_shared<std::recursive_mutex>();
+    return {[manager, mtx](DcpPdu &msg) {
+        if (msg.getTypeId() == DcpPduType::DAT_input_output) {
+            manager.receive(msg);
+            return;
+        }
+        std::lock_guard<std::recursive_mutex> lock(*mtx);
+        manager.receive(msg);
+    }, [manager, mtx](const DcpError errorCode) {
+        std::lock_guard<std::recursive_mutex> lock(*mtx);
+        manager.reportError(errorCode);
+    }};
+}
+
+#endif //DCPLIB_IOENGINE_HPP
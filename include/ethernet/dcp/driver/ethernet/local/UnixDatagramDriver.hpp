@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_UNIXDATAGRAMDRIVER_H
+#define DCPLIB_UNIXDATAGRAMDRIVER_H
+
+#define ASIO_STANDALONE
+
+#include <dcp/driver/ethernet/local/helper/LocalHelper.hpp>
+#include <dcp/driver/ethernet/udp/UdpDriver.hpp>
+
+/**
+ * UdpDriver over unix domain datagram sockets, for slaves on the same host as their master.
+ * The master configures the slave with UDP_IPv4 network information, the port selects the socket path
+ * (see Local::toPath). Unix domain sockets bypass the IP stack, which lowers the latency compared to
+ * UDP over loopback.
+ */
+class UnixDatagramDriver : public BasicUdpDriver<asio::local::datagram_protocol> {
+public:
+    /**
+     * @param port Port of the control socket
+     * @param directory Directory of the socket files, empty for the abstract namespace (Linux only)
+     * @param batchSize Maximum number of datagrams received or sent per system call (recvmmsg/sendmmsg).
+     * 1 disables batching. Batching is only supported on Linux
+     * @param ioThreads Number of threads running the io_service
+     */
+    UnixDatagramDriver(uint16_t port, std::string directory = "", size_t batchSize = 1, size_t ioThreads = 1) :
+            BasicUdpDriver("0.0.0.0", port, [directory](port_t port, ip_address_t) {
+                return asio::local::datagram_protocol::endpoint(Local::toPath(directory, port));
+            }, batchSize, ioThreads) {}
+};
+
+#endif //DCPLIB_UNIXDATAGRAMDRIVER_H
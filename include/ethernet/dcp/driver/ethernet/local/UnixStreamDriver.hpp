@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_UNIXSTREAMDRIVER_H
+#define DCPLIB_UNIXSTREAMDRIVER_H
+
+#define ASIO_STANDALONE
+
+#include <dcp/driver/ethernet/local/helper/LocalHelper.hpp>
+#include <dcp/driver/ethernet/tcp/TcpDriver.hpp>
+
+/**
+ * TcpDriver over unix domain stream sockets, for slaves on the same host as their master.
+ * The master configures the slave with TCP_IPv4 network information, the port selects the socket path
+ * (see Local::toPath).
+ */
+class UnixStreamDriver : public BasicTcpDriver<asio::local::stream_protocol> {
+public:
+    /**
+     * @param port Port of the control server
+     * @param directory Directory of the socket files, empty for the abstract namespace (Linux only)
+     * @param ioThreads Number of threads running the io_service
+     */
+    UnixStreamDriver(uint16_t port, std::string directory = "", size_t ioThreads = 1) :
+            BasicTcpDriver("0.0.0.0", port, [directory](port_t port, ip_address_t) {
+                return asio::local::stream_protocol::endpoint(Local::toPath(directory, port));
+            }, ioThreads) {}
+};
+
+#endif //DCPLIB_UNIXSTREAMDRIVER_H
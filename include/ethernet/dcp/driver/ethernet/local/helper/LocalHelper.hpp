@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_LOCALHELPER_H
+#define DCPLIB_LOCALHELPER_H
+
+#include <dcp/model/DcpTypes.hpp>
+#include <asio.hpp>
+
+#include <string>
+#include <unistd.h>
+
+namespace Local {
+    static std::string protocolName = "AF_UNIX";
+
+    /**
+     * Path of the socket for the port of a network information. All endpoints of a unix domain socket
+     * are on the same host, so the ip of the network information is not part of the path.
+     * @param directory Directory of the socket files. Empty uses the abstract namespace (Linux only),
+     * which needs no cleanup when the process exits
+     * @param port Port of the network information
+     */
+    static std::string toPath(const std::string &directory, port_t port) {
+        std::string name = "dcplib_" + std::to_string(port);
+        if (directory.empty()) {
+            return std::string(1, '\0') + name;
+        }
+        if (directory.back() == '/') {
+            return directory + name;
+        }
+        return directory + "/" + name;
+    }
+
+    template<class Endpoint>
+    struct Traits {
+        static const std::string &name() {
+            return protocolName;
+        }
+
+        static std::string to_string(const Endpoint &endpoint) {
+            std::string path = endpoint.path();
+            if (!path.empty() && path[0] == '\0') {
+                //abstract namespace, printed like ss does
+                path[0] = '@';
+            }
+            return path;
+        }
+
+        /**
+         * Removes the socket file of a previous run, binding to an existing path fails.
+         */
+        static const Endpoint &prepareBind(const Endpoint &endpoint) {
+            std::string path = endpoint.path();
+            if (!path.empty() && path[0] != '\0') {
+                ::unlink(path.c_str());
+            }
+            return endpoint;
+        }
+
+        /**
+         * Nothing to configure for unix domain sockets
+         */
+        template<class Socket>
+        static void prepareConnection(Socket &) {
+        }
+    };
+}
+
+template<class Protocol>
+struct ProtocolTraits;
+
+template<>
+struct ProtocolTraits<asio::local::datagram_protocol>
+        : public Local::Traits<asio::local::datagram_protocol::endpoint> {
+};
+
+template<>
+struct ProtocolTraits<asio::local::stream_protocol> : public Local::Traits<asio::local::stream_protocol::endpoint> {
+};
+
+#endif //DCPLIB_LOCALHELPER_H
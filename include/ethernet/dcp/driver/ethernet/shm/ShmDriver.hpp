@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_SHMDRIVER_H
+#define DCPLIB_SHMDRIVER_H
+
+#include <dcp/driver/ethernet/shm/helper/ShmRing.hpp>
+#include <dcp/driver/DcpDriver.hpp>
+#include <dcp/driver/ethernet/ErrorCodes.hpp>
+#include <dcp/logic/Logable.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Shm {
+    static std::string protocolName = "SHM";
+}
+
+/**
+ * Driver for slaves on the same host. It extends the driver of a network transport protocol
+ * (network information in the UDP_IPv4 format):
+ * DAT_input_output PDUs whose network information points to a local address are exchanged through a
+ * single-producer/single-consumer ring in /dev/shm, one per data id. All other PDUs use the wrapped driver.
+ * Outputs are serialized directly into the ring slots and inputs are dispatched from them.
+ *
+ * Usage:
+ * UdpDriver udpDriver(host, port);
+ * ShmDriver shmDriver(udpDriver.getDcpDriver());
+ * DcpManagerSlave manager(slaveDescription, shmDriver.getDcpDriver());
+ */
+class ShmDriver : public Logable {
+public:
+    /**
+     * @param transport Driver used for control PDUs and for slaves on other hosts
+     * @param slotCount Number of PDU slots of each ring, has to be the same for all slaves
+     * @param localAddresses Addresses of this host besides 127.0.0.0/8
+     */
+    ShmDriver(DcpDriver transport, uint32_t slotCount = 64, std::set<ip_address_t> localAddresses = {}) :
+            transport(transport), slotCount(slotCount), localAddresses(localAddresses) {}
+
+    ~ShmDriver() {
+        closeConfiguredPorts();
+    }
+
+    DcpDriver getDcpDriver() {
+        return {[this](DcpPdu &msg) { this->send(msg); },
+                [this](dcpId_t dcpId, uint8_t *info) {
+                    transport.setSlaveNetworkInformation(dcpId, info);
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    setSourceNetworkInformation(dataId, info);
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    setTargetNetworkInformation(dataId, info);
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    transport.setParamNetworkInformation(paramId, info);
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    transport.setTargetParamNetworkInformation(paramId, info);
+                },
+                [this]() { transport.startReceiving(); },
+                [this](dcpId_t dcpId) { transport.connectToSlave(dcpId); },
+                [this](dcpId_t dcpId) { transport.disconnectFromSlave(dcpId); },
+                [this](DcpManager manager) {
+                    setDcpManager(manager);
+                },
+                [this](const LogManager &logManager) {
+                    setLogManager(logManager);
+                    transport.setLogManager(logManager);
+                },
+                [this]() { transport.registerSuccessfull(); },
+                [this]() {
+                    openPorts();
+                    transport.prepare();
+                },
+                [this]() { transport.configure(); },
+                [this]() {
+                    closeConfiguredPorts();
+                    transport.stop();
+                },
+                [this]() { transport.disconnect(); },
+                [this](DcpPdu **pdus, size_t count) { this->sendBatch(pdus, count); },
+                [this](dataId_t dataId, size_t size) { return this->acquireOutput(dataId, size); },
+        };
+    }
+
+private:
+    DcpDriver transport;
+    uint32_t slotCount;
+    std::set<ip_address_t> localAddresses;
+
+    DcpManager dcpManager;
+    //Serializes the PDUs passed to the manager by the reader threads and the wrapped driver. A synchronous wrapped
+    //driver may reenter receive on the same thread when the manager answers from within a listener
+    std::recursive_mutex mtxReceive;
+
+    std::map<dataId_t, std::unique_ptr<ShmRing>> ringsOut;
+    std::map<dataId_t, std::string> ringsInConfigured;
+    std::vector<std::unique_ptr<ShmRing>> ringsIn;
+    std::vector<std::thread> readers;
+    std::atomic<bool> stopReaders{false};
+    //PDUs of a batch which are passed to the wrapped driver
+    std::vector<DcpPdu *> transportBatch;
+
+    bool isLocal(ip_address_t ip) const {
+        return (ip >> 24) == 127 || localAddresses.count(ip) > 0;
+    }
+
+    static std::string ringName(dataId_t dataId, port_t port, ip_address_t ip) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "/dcplib_%08x_%u_%u", ip, (unsigned) port, (unsigned) dataId);
+        return name;
+    }
+
+    void setDcpManager(DcpManager manager) {
+        dcpManager = manager;
+        transport.setDcpManager({[this](DcpPdu &msg) {
+            std::lock_guard<std::recursive_mutex> lock(mtxReceive);
+            dcpManager.receive(msg);
+        }, manager.reportError});
+    }
+
+    void setSourceNetworkInformation(dataId_t dataId, uint8_t *info) {
+        port_t port = *((uint16_t *) info);
+        ip_address_t ip = *((ip_address_t *) (info + 2));
+        if (isLocal(ip)) {
+            ringsInConfigured[dataId] = ringName(dataId, port, ip);
+        } else {
+            transport.setSourceNetworkInformation(dataId, info);
+        }
+    }
+
+    void setTargetNetworkInformation(dataId_t dataId, uint8_t *info) {
+        port_t port = *((uint16_t *) info);
+        ip_address_t ip = *((ip_address_t *) (info + 2));
+        if (!isLocal(ip)) {
+            ringsOut.erase(dataId);
+            transport.setTargetNetworkInformation(dataId, info);
+            return;
+        }
+        try {
+            ringsOut[dataId] = std::unique_ptr<ShmRing>(new ShmRing(ringName(dataId, port, ip), slotCount));
+        } catch (std::exception &e) {
+            ringsOut.erase(dataId);
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+            Log(NETWORK_PROBLEM, Shm::protocolName, e.what());
+#endif
+        }
+    }
+
+    uint8_t *acquireOutput(dataId_t dataId, size_t size) {
+        auto it = ringsOut.find(dataId);
+        if (it == ringsOut.end() || size > ShmRing::slotSize) {
+            return nullptr;
+        }
+        return it->second->acquire();
+    }
+
+    /**
+     * Publish a DAT_input_output PDU into its ring.
+     * @return false if the PDU is not exchanged through shared memory
+     */
+    bool sendShm(DcpPdu &msg) {
+        if (msg.getTypeId() != DcpPduType::DAT_input_output) {
+            return false;
+        }
+        auto it = ringsOut.find(static_cast<DcpPduDatInputOutput &>(msg).getDataId());
+        if (it == ringsOut.end()) {
+            return false;
+        }
+#if defined(DEBUG)
+        if (isLogged(PDU_SEND)) {
+            Log(PDU_SEND, msg.to_string());
+        }
+#endif
+        ShmRing &ring = *it->second;
+        uint8_t *slot = ring.acquire();
+        if (slot == nullptr) {
+            //the receiver does not keep up, like a full socket buffer the PDU is lost
+            return true;
+        }
+        if (slot != msg.serialize()) {
+            if (msg.getSerializedSize() > ShmRing::slotSize) {
+                dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+                Log(NETWORK_PROBLEM, Shm::protocolName, std::string("PDU exceeds slot of ") + ring.getName());
+#endif
+                return true;
+            }
+            std::memcpy(slot, msg.serialize(), msg.getSerializedSize());
+        }
+        ring.publish();
+        return true;
+    }
+
+    void send(DcpPdu &msg) {
+        if (!sendShm(msg)) {
+            transport.send(msg);
+        }
+    }
+
+    void sendBatch(DcpPdu **pdus, size_t count) {
+        transportBatch.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (!sendShm(*pdus[i])) {
+                transportBatch.push_back(pdus[i]);
+            }
+        }
+        if (transportBatch.empty()) {
+            return;
+        }
+        if (transport.sendBatch) {
+            transport.sendBatch(transportBatch.data(), transportBatch.size());
+        } else {
+            for (DcpPdu *pdu : transportBatch) {
+                transport.send(*pdu);
+            }
+        }
+    }
+
+    void openPorts() {
+        stopReaders = false;
+        for (auto &pos : ringsInConfigured) {
+            try {
+                ShmRing *ring = new ShmRing(pos.second, slotCount);
+                ringsIn.push_back(std::unique_ptr<ShmRing>(ring));
+                ring->discard();
+                readers.push_back(std::thread(&ShmDriver::read, this, ring));
+#if defined(DEBUG)
+                Log(NEW_SOCKET, Shm::protocolName, pos.second);
+#endif
+            } catch (std::exception &e) {
+                dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+                Log(NETWORK_PROBLEM, Shm::protocolName, e.what());
+#endif
+            }
+        }
+    }
+
+    void closeConfiguredPorts() {
+        stopReaders = true;
+        for (auto &ring : ringsIn) {
+            ring->wake();
+        }
+        for (std::thread &reader : readers) {
+            reader.join();
+        }
+        readers.clear();
+        for (auto &ring : ringsIn) {
+            ring->unlink();
+#if defined(DEBUG)
+            Log(SOCKET_CLOSED, Shm::protocolName, ring->getName());
+#endif
+        }
+        ringsIn.clear();
+        ringsInConfigured.clear();
+    }
+
+    /**
+     * Reader thread of one ring. Dispatches each PDU from its slot.
+     */
+    void read(ShmRing *ring) {
+        while (ring->wait(stopReaders)) {
+            uint8_t *slot;
+            while ((slot = ring->front()) != nullptr) {
+                if (*((uint32_t *) slot) > ShmRing::slotSize - PDU_LENGTH_INDICATOR_SIZE) {
+                    ring->pop();
+                    continue;
+                }
+                {
+                    DcpPduView pdu(slot, *((uint32_t *) slot));
+                    std::lock_guard<std::recursive_mutex> lock(mtxReceive);
+#if defined(DEBUG)
+                    if (isLogged(PDU_RECEIVED)) {
+                        Log(PDU_RECEIVED, pdu->to_string());
+                    }
+#endif
+                    dcpManager.receive(*pdu);
+                }
+                ring->pop();
+            }
+        }
+    }
+};
+
+#endif //DCPLIB_SHMDRIVER_H
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_SHMRING_H
+#define DCPLIB_SHMRING_H
+
+#include <dcp/model/pdu/DcpPdu.hpp>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+/**
+ * Single-producer/single-consumer ring of PDU slots in a POSIX shared memory object (/dev/shm).
+ * A slot holds one PDU in its serialized form, length indicator included, so the producer serializes
+ * into the slot and the consumer dispatches from it without copying.
+ * Both sides open the ring by name, whichever comes first creates it.
+ */
+class ShmRing {
+public:
+    //length indicator and PDU, a multiple of the cache line size
+    static const uint32_t slotSize = 1088;
+
+    /**
+     * @param name Name of the shared memory object, starting with '/'
+     * @param slotCount Number of slots, has to be the same on both sides
+     * @throws std::system_error if the shared memory object can not be opened or mapped
+     */
+    ShmRing(const std::string &name, uint32_t slotCount) : name(name), slotCount(slotCount) {
+        fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::system_category(), "shm_open " + name);
+        }
+        size = sizeof(Header) + (size_t) slotCount * slotSize;
+        struct stat st;
+        if (fstat(fd, &st) < 0 || (st.st_size == 0 && ftruncate(fd, size) < 0)) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "ftruncate " + name);
+        }
+        if (st.st_size != 0 && (size_t) st.st_size != size) {
+            close(fd);
+            throw std::system_error(EINVAL, std::system_category(), "slot count of " + name);
+        }
+        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (memory == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "mmap " + name);
+        }
+        header = (Header *) memory;
+        slots = (uint8_t *) memory + sizeof(Header);
+    }
+
+    ~ShmRing() {
+        munmap(header, size);
+        close(fd);
+    }
+
+    ShmRing(const ShmRing &) = delete;
+
+    ShmRing &operator=(const ShmRing &) = delete;
+
+    /**
+     * Producer: the next free slot. Repeated calls return the same slot until it is published.
+     * @return the slot or nullptr if the ring is full
+     */
+    uint8_t *acquire() {
+        const uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        if (tail - header->head.load(std::memory_order_acquire) >= slotCount) {
+            return nullptr;
+        }
+        return slot(tail);
+    }
+
+    /**
+     * Producer: hand the acquired slot to the consumer.
+     */
+    void publish() {
+        header->tail.store(header->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        wake();
+    }
+
+    /**
+     * Consumer: the oldest published slot or nullptr if the ring is empty.
+     */
+    uint8_t *front() {
+        const uint64_t head = header->head.load(std::memory_order_relaxed);
+        if (head == header->tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return slot(head);
+    }
+
+    /**
+     * Consumer: release the slot returned by front to the producer.
+     */
+    void pop() {
+        header->head.store(header->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Consumer: drop everything a previous run left in the ring.
+     */
+    void discard() {
+        header->head.store(header->tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * Consumer: block until a slot is published or stop is set.
+     * @return false if stop is set
+     */
+    bool wait(const std::atomic<bool> &stop) {
+        for (;;) {
+            const uint32_t signal = header->signal.load();
+            if (stop.load()) {
+                return false;
+            }
+            if (front() != nullptr) {
+                return true;
+            }
+            header->waiting.store(1);
+            if (front() == nullptr && !stop.load()) {
+                syscall(SYS_futex, &header->signal, FUTEX_WAIT, signal, nullptr, nullptr, 0);
+            }
+            header->waiting.store(0);
+        }
+    }
+
+    /**
+     * Wake a consumer blocked in wait.
+     */
+    void wake() {
+        header->signal.fetch_add(1);
+        if (header->waiting.load() != 0) {
+            syscall(SYS_futex, &header->signal, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        }
+    }
+
+    /**
+     * Remove the name of the shared memory object. Mappings stay valid.
+     */
+    void unlink() {
+        shm_unlink(name.c_str());
+    }
+
+    const std::string &getName() const {
+        return name;
+    }
+
+private:
+    struct Header {
+        alignas(64) std::atomic<uint64_t> tail;
+        //incremented on every publish, consumers wait on it with a futex
+        std::atomic<uint32_t> signal;
+        std::atomic<uint32_t> waiting;
+        alignas(64) std::atomic<uint64_t> head;
+    };
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32 bit word");
+
+    std::string name;
+    uint32_t slotCount;
+    int fd;
+    size_t size;
+    Header *header;
+    uint8_t *slots;
+
+    inline uint8_t *slot(uint64_t index) {
+        return slots + (size_t) (index % slotCount) * slotSize;
+    }
+};
+
+#endif //DCPLIB_SHMRING_H
@@ -14,16 +14,34 @@
 
 
 #include <dcp/driver/ethernet/tcp/helper/TcpHelper.hpp>
+#include <dcp/driver/ethernet/IoEngine.hpp>
 #include <iostream>
 #include <chrono>
 #include <thread>
 
-class TcpDriver : public Logable {
+/**
+ * Driver for connection oriented stream protocols. Network information is given in the TCP_IPv4 format.
+ * @tparam Protocol asio stream protocol, e.g. asio::ip::tcp or asio::local::stream_protocol
+ */
+template<class Protocol>
+class BasicTcpDriver : public Logable {
 public:
-
-    TcpDriver(std::string host, uint16_t port) : mainPort(port), mainHost(host) {}
-
-    ~TcpDriver() {
+    typedef typename Protocol::endpoint endpoint_type;
+    //Maps the port and ip of a network information to an endpoint of Protocol
+    typedef std::function<endpoint_type(port_t, ip_address_t)> EndpointFactory;
+
+    /**
+     * @param host Host of the control server
+     * @param port Port of the control server
+     * @param toEndpoint Maps network information to endpoints
+     * @param ioThreads Number of threads running the io_service. Each port keeps the order of its PDUs,
+     * DAT_input_output PDUs of different ports may be passed to the DcpManager concurrently,
+     * other PDUs one at a time.
+     */
+    BasicTcpDriver(std::string host, uint16_t port, EndpointFactory toEndpoint, size_t ioThreads) :
+            mainPort(port), mainHost(host), toEndpoint(toEndpoint), ioThreads(ioThreads == 0 ? 1 : ioThreads) {}
+
+    ~BasicTcpDriver() {
         closeConfiguredPorts();
         disconnect();
     }
@@ -47,31 +65,35 @@ public:
                 [this](paramId_t paramId, uint8_t *info) {
                     setTargetParamNetworkInformation(paramId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
                 },
-                std::bind(&TcpDriver::startReceiving, this),
-                std::bind(&TcpDriver::connectToSlave, this, std::placeholders::_1),
-                std::bind(&TcpDriver::disconnectFromSlave, this, std::placeholders::_1),
+                std::bind(&BasicTcpDriver::startReceiving, this),
+                std::bind(&BasicTcpDriver::connectToSlave, this, std::placeholders::_1),
+                std::bind(&BasicTcpDriver::disconnectFromSlave, this, std::placeholders::_1),
                 [this](DcpManager manager) {
-                    this->dcpManager = manager;
+                    this->dcpManager = serializeManager(manager, ioThreads);
                 },
 
                 [this](const LogManager &logManager) {
                     setLogManager(logManager);
                 },
-                std::bind(&TcpDriver::registerSuccessfull, this),
-                std::bind(&TcpDriver::openPorts, this),
-                std::bind(&TcpDriver::connectToConfiguredPorts, this),
-                std::bind(&TcpDriver::closeConfiguredPorts, this),
-                std::bind(&TcpDriver::disconnect, this),
+                std::bind(&BasicTcpDriver::registerSuccessfull, this),
+                std::bind(&BasicTcpDriver::openPorts, this),
+                std::bind(&BasicTcpDriver::connectToConfiguredPorts, this),
+                std::bind(&BasicTcpDriver::closeConfiguredPorts, this),
+                std::bind(&BasicTcpDriver::disconnect, this),
         };
     }
 
 private:
+    typedef BasicServer<Protocol> Server;
+    typedef BasicClient<Protocol> Client;
 
     asio::io_service io_service;
 
     DcpManager dcpManager;
     uint16_t mainPort;
     std::string mainHost;
+    EndpointFactory toEndpoint;
+    size_t ioThreads;
 
     std::shared_ptr<Server> mainServer;
     size_t mainSession;
@@ -83,7 +105,7 @@ private:
     std::map<paramId_t, std::shared_ptr<Client>> parameterClients;
 
     inline std::shared_ptr<Client> getClient(asio::io_service &, port_t port, ip_address_t ip, DcpManager &dcpManager) {
-        asio::ip::tcp::endpoint endpoint(asio::ip::address_v4(ip), port);
+        endpoint_type endpoint = toEndpoint(port, ip);
         for (const auto &it : otherSlaves) {
             if (it.second->getEndpoint() == endpoint) {
                 return it.second;
@@ -104,7 +126,7 @@ private:
 
     inline std::shared_ptr<Server>
     getServer(asio::io_service &ios, port_t port, ip_address_t ip, DcpManager &manager, LogManager &_logManager) {
-        asio::ip::tcp::endpoint endpoint(asio::ip::address_v4(ip), port);
+        endpoint_type endpoint = toEndpoint(port, ip);
         if (mainServer->getEndpoint() == endpoint) {
             return mainServer;
         }
@@ -118,8 +140,7 @@ private:
                 return it.second;
             }
         }
-        return std::make_shared<Server>(io_service, asio::ip::tcp::endpoint(asio::ip::address_v4(ip), port), dcpManager,
-                                        logManager);
+        return std::make_shared<Server>(io_service, endpoint, dcpManager, logManager);
     }
 
     void send(DcpPdu &msg) {
@@ -208,17 +229,16 @@ private:
         }
         try {
             mainServer = std::make_shared<Server>(io_service,
-                                                  asio::ip::tcp::endpoint(asio::ip::address_v4::from_string(mainHost),
-                                                                          mainPort),
+                                                  toEndpoint(mainPort,
+                                                             asio::ip::address_v4::from_string(mainHost).to_ulong()),
                                                   dcpManager,
                                                   logManager);
             mainServer->start();
-            asio::io_service::work work(io_service);
-            io_service.run();
+            runIoService(io_service, ioThreads);
         } catch (std::exception &e) {
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Tcp::protocolName, e.what());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
         }
     }
@@ -234,8 +254,8 @@ private:
     void registerSuccessfull() {
         mainSession = mainServer->getLastSessionAccess();
 #if defined(DEBUG)
-        Log(NEW_MASTER_ENDPOINT, Tcp::protocolName,
-            to_string(mainServer->getSession(mainSession)->getSocket().remote_endpoint()));
+        Log(NEW_MASTER_ENDPOINT, ProtocolTraits<Protocol>::name(),
+            ProtocolTraits<Protocol>::to_string(mainServer->getSession(mainSession)->getSocket().remote_endpoint()));
 #endif
     }
 
@@ -250,7 +270,7 @@ private:
         } catch (std::exception &e) {
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Tcp::protocolName, e.what());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
         }
     }
@@ -266,7 +286,7 @@ private:
         } catch (std::exception &e) {
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Tcp::protocolName, e.what());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
         }
     }
@@ -285,4 +305,19 @@ private:
 
 };
 
+class TcpDriver : public BasicTcpDriver<asio::ip::tcp> {
+public:
+    /**
+     * @param host Host of the control server
+     * @param port Port of the control server
+     * @param ioThreads Number of threads running the io_service. Each port keeps the order of its PDUs,
+     * DAT_input_output PDUs of different ports may be passed to the DcpManager concurrently,
+     * other PDUs one at a time.
+     */
+    TcpDriver(std::string host, uint16_t port, size_t ioThreads = 1) :
+            BasicTcpDriver(host, port, [](port_t port, ip_address_t ip) {
+                return asio::ip::tcp::endpoint(asio::ip::address_v4(ip), port);
+            }, ioThreads) {}
+};
+
 #endif //DCPLIB_TCP_DRIVER_H
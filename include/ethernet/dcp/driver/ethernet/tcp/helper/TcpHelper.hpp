@@ -12,6 +12,7 @@
 #include <dcp/driver/DcpDriver.hpp>
 #include <dcp/logic/Logable.hpp>
 #include <dcp/driver/ethernet/ErrorCodes.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
 #include <asio.hpp>
 
 namespace Tcp {
@@ -24,6 +25,41 @@ static std::string to_string(const asio::ip::tcp::endpoint &remote_endpoint) {
     return oss.str();
 }
 
+/**
+ * Log name and bind preparation of a protocol, specialized per protocol.
+ */
+template<class Protocol>
+struct ProtocolTraits;
+
+template<>
+struct ProtocolTraits<asio::ip::tcp> {
+    static const std::string &name() {
+        return Tcp::protocolName;
+    }
+
+    static std::string to_string(const asio::ip::tcp::endpoint &endpoint) {
+        return ::to_string(endpoint);
+    }
+
+    /**
+     * Called before an acceptor is bound to endpoint
+     * @return the endpoint to bind to
+     */
+    static const asio::ip::tcp::endpoint &prepareBind(const asio::ip::tcp::endpoint &endpoint) {
+        return endpoint;
+    }
+
+    /**
+     * Called once a connection is established, before the first PDU is sent or received.
+     * Disables Nagle's algorithm, every PDU is a complete message and otherwise waits for the delayed ack of the
+     * previous one. Failing to do so only costs latency, so errors are ignored
+     */
+    static void prepareConnection(asio::ip::tcp::socket &socket) {
+        std::error_code ignored;
+        socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+    }
+};
+
 class SessionManager {
 public:
     virtual ~SessionManager() {}
@@ -33,20 +69,27 @@ public:
     virtual void setLastSessionAccess(size_t lastSessionAccess) = 0;
 };
 
-class Session : public Logable, public std::enable_shared_from_this<Session> {
+/**
+ * Connection of a stream socket. PDUs are framed by their length indicator.
+ * @tparam Protocol asio stream protocol, e.g. asio::ip::tcp or asio::local::stream_protocol
+ */
+template<class Protocol>
+class BasicSession : public Logable, public std::enable_shared_from_this<BasicSession<Protocol>> {
 public:
-    Session(asio::io_service &ios, DcpManager &manager, std::shared_ptr<SessionManager> _sessionManager, size_t cId)
-            : dcpManager(manager), sessionManager(_sessionManager), id(cId) {
-        this->socket = std::make_shared<asio::ip::tcp::socket>(ios);
+    BasicSession(asio::io_service &ios, DcpManager &manager, std::shared_ptr<SessionManager> _sessionManager, size_t cId,
+            std::shared_ptr<asio::io_service::strand> strand)
+            : dcpManager(manager), sessionManager(_sessionManager), id(cId), strand(strand) {
+        this->socket = std::make_shared<typename Protocol::socket>(ios);
     }
 
-    Session(std::shared_ptr<asio::ip::tcp::socket> socket, DcpManager &manager)
-            : dcpManager(manager), id(0) {
+    BasicSession(std::shared_ptr<typename Protocol::socket> socket, DcpManager &manager,
+            std::shared_ptr<asio::io_service::strand> strand)
+            : dcpManager(manager), id(0), strand(strand) {
         this->socket = socket;
         this->sessionManager = nullptr;
     }
 
-    asio::ip::tcp::socket &getSocket() {
+    typename Protocol::socket &getSocket() {
         return *socket;
     }
 
@@ -57,13 +100,13 @@ public:
     void prepareRead() {
         asio::async_read(*socket,
                          asio::buffer(data, maxLength),
-                         std::bind(&Session::completion_condition, this,
+                         std::bind(&BasicSession::completion_condition, this,
                                    std::placeholders::_1,
                                    std::placeholders::_2),
-                         std::bind(&Session::handleRead, this,
-                                   shared_from_this(),
-                                   std::placeholders::_1,
-                                   std::placeholders::_2));
+                         strand->wrap(std::bind(&BasicSession::handleRead, this,
+                                                this->shared_from_this(),
+                                                std::placeholders::_1,
+                                                std::placeholders::_2)));
     }
 
     std::size_t completion_condition(const std::error_code &error, std::size_t bytes_transferred) {
@@ -73,17 +116,18 @@ public:
         return 4 - bytes_transferred;
     }
 
-    void handleRead(std::shared_ptr<Session> s, const std::error_code &error, size_t bytes_transferred) {
+    void handleRead(std::shared_ptr<BasicSession> s, const std::error_code &error, size_t bytes_transferred) {
         if (!error) {
             if (sessionManager != nullptr) {
                 sessionManager->setLastSessionAccess(id);
             }
-            DcpPdu *pdu = makeDcpPdu(data, bytes_transferred - 4);
+            DcpPduView pdu(data, bytes_transferred - 4);
 #if defined(DEBUG)
-            Log(PDU_RECEIVED, pdu->to_string());
+            if (isLogged(PDU_RECEIVED)) {
+                Log(PDU_RECEIVED, pdu->to_string());
+            }
 #endif
             dcpManager.receive(*pdu);
-            delete pdu;
 
             prepareRead();
 
@@ -100,7 +144,7 @@ public:
 
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Tcp::protocolName, error.message());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), error.message());
 #endif
             if (sessionManager != nullptr) {
                 sessionManager->removeSession(id);
@@ -112,7 +156,9 @@ public:
 
     void send(DcpPdu &msg) {
 #if defined(DEBUG)
-        Log(PDU_SEND, msg.to_string());
+        if (isLogged(PDU_SEND)) {
+            Log(PDU_SEND, msg.to_string());
+        }
 #endif
         std::error_code error;
         try {
@@ -121,7 +167,7 @@ public:
                     0, error);
             if (error && error != asio::error::message_size) {
 #if defined(DEBUG) || defined(LOGGING)
-                Log(NETWORK_PROBLEM, Tcp::protocolName, error.message());
+                Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), error.message());
 #endif
                 dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
             }
@@ -129,7 +175,7 @@ public:
             std::cerr << e.what() << std::endl;
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Tcp::protocolName, e.what());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
         }
     }
@@ -140,7 +186,7 @@ public:
 
 
 private:
-    std::shared_ptr<asio::ip::tcp::socket> socket;
+    std::shared_ptr<typename Protocol::socket> socket;
     enum {
         maxLength = 1024
     };
@@ -148,23 +194,34 @@ private:
     uint8_t data[maxLength];
     DcpManager &dcpManager;
     std::shared_ptr<SessionManager> sessionManager;
+    //Strand of the port this session belongs to
+    std::shared_ptr<asio::io_service::strand> strand;
 };
 
-class Server : public Logable, public SessionManager, public std::enable_shared_from_this<Server> {
+/**
+ * Accepts connections on a stream socket and receives PDUs from all of them.
+ * @tparam Protocol asio stream protocol, e.g. asio::ip::tcp or asio::local::stream_protocol
+ */
+template<class Protocol>
+class BasicServer : public Logable, public SessionManager, public std::enable_shared_from_this<BasicServer<Protocol>> {
 public:
-    Server(asio::io_service &ios, asio::ip::tcp::endpoint _endpoint, DcpManager &manager, LogManager &_logManager) :
-            ios(ios), endpoint(_endpoint), acceptor(ios, _endpoint), dcpManager(manager), started(false) {
+    typedef BasicSession<Protocol> Session;
+
+    BasicServer(asio::io_service &ios, typename Protocol::endpoint _endpoint, DcpManager &manager,
+                LogManager &_logManager) :
+            ios(ios), strand(std::make_shared<asio::io_service::strand>(ios)), endpoint(_endpoint),
+            acceptor(ios, ProtocolTraits<Protocol>::prepareBind(_endpoint)), dcpManager(manager), started(false) {
         setLogManager(_logManager);
     }
 
-    ~Server() {
+    ~BasicServer() {
         acceptor.cancel();
         for (auto &it: sessions) {
             it.second->getSocket().cancel();
             it.second->getSocket().close();
         }
 #if defined(DEBUG)
-        Log(SOCKET_CLOSED, Tcp::protocolName, to_string(endpoint));
+        Log(SOCKET_CLOSED, ProtocolTraits<Protocol>::name(), ProtocolTraits<Protocol>::to_string(endpoint));
 #endif
     }
 
@@ -172,7 +229,7 @@ public:
         if (!started) {
             prepareAccept();
 #if defined(DEBUG)
-            Log(NEW_SOCKET, Tcp::protocolName, to_string(endpoint));
+            Log(NEW_SOCKET, ProtocolTraits<Protocol>::name(), ProtocolTraits<Protocol>::to_string(endpoint));
 #endif
             started = true;
         }
@@ -180,24 +237,25 @@ public:
 
     void prepareAccept() {
         sessionCounter++;
-        std::shared_ptr<Session> session = std::make_shared<Session>(ios, dcpManager, shared_from_this(),
-                                                                     sessionCounter);
+        std::shared_ptr<Session> session = std::make_shared<Session>(ios, dcpManager, this->shared_from_this(),
+                                                                     sessionCounter, strand);
         acceptor.async_accept(session->getSocket(),
-                              std::bind(&Server::handle_accept,
-                                        this,
-                                        session,
-                                        std::placeholders::_1));
+                              strand->wrap(std::bind(&BasicServer::handle_accept,
+                                                     this,
+                                                     session,
+                                                     std::placeholders::_1)));
     }
 
     void handle_accept(std::shared_ptr<Session> session,
                        const std::error_code &error) {
         if (!error) {
+            ProtocolTraits<Protocol>::prepareConnection(session->getSocket());
             sessions[session->getId()] = session->shared_from_this();
 
             session->setLogManager(logManager);
             session->start();
 #if defined(DEBUG)
-            Log(NEW_TCP_CONNECTION_IN, to_string(session->getSocket().remote_endpoint()));
+            Log(NEW_TCP_CONNECTION_IN, ProtocolTraits<Protocol>::to_string(session->getSocket().remote_endpoint()));
 #endif
             prepareAccept();
         } else {
@@ -217,7 +275,7 @@ public:
         return sessions[lastSessionAccess];
     }
 
-    const asio::ip::tcp::endpoint &getEndpoint() const {
+    const typename Protocol::endpoint &getEndpoint() const {
         return endpoint;
     }
 
@@ -226,14 +284,14 @@ public:
     }
 
     virtual void setLastSessionAccess(size_t lastSessionAccess) {
-        Server::lastSessionAccess = lastSessionAccess;
+        BasicServer::lastSessionAccess = lastSessionAccess;
     }
 
     void clearNonMainSessions(size_t mainSession) {
         for (auto it = sessions.cbegin(); it != sessions.cend() /* not hoisted */; /* no increment */) {
             if (it->first != mainSession) {
 #if defined(DEBUG)
-                Log(TCP_CONNECTION_CLOSED, to_string(it->second->getSocket().remote_endpoint()));
+                Log(TCP_CONNECTION_CLOSED, ProtocolTraits<Protocol>::to_string(it->second->getSocket().remote_endpoint()));
 #endif
                 it->second->getSocket().close();
                 sessions.erase(it++);
@@ -246,7 +304,7 @@ public:
     void clearSessions() {
         for (auto it = sessions.cbegin(); it != sessions.cend() /* not hoisted */; /* no increment */) {
 #if defined(DEBUG)
-            Log(TCP_CONNECTION_CLOSED, to_string(it->second->getSocket().remote_endpoint()));
+            Log(TCP_CONNECTION_CLOSED, ProtocolTraits<Protocol>::to_string(it->second->getSocket().remote_endpoint()));
 #endif
             it->second->getSocket().close();
             sessions.erase(it++);
@@ -255,8 +313,10 @@ public:
 
 private:
     asio::io_service &ios;
-    asio::ip::tcp::endpoint endpoint;
-    asio::ip::tcp::acceptor acceptor;
+    //Serializes accepting and reading of all sessions of this port
+    std::shared_ptr<asio::io_service::strand> strand;
+    typename Protocol::endpoint endpoint;
+    typename Protocol::acceptor acceptor;
     DcpManager &dcpManager;
     size_t sessionCounter;
     std::map<size_t, std::shared_ptr<Session>> sessions;
@@ -265,21 +325,29 @@ private:
 };
 
 
-class Client : public Logable {
+/**
+ * Connection to a BasicServer, PDUs are sent and received over one session.
+ * @tparam Protocol asio stream protocol, e.g. asio::ip::tcp or asio::local::stream_protocol
+ */
+template<class Protocol>
+class BasicClient : public Logable {
 public:
-    Client(asio::io_service &ios, asio::ip::tcp::endpoint _endpoint, DcpManager &manager, LogManager &logManager) : dcpManager(
+    typedef BasicSession<Protocol> Session;
+
+    BasicClient(asio::io_service &ios, typename Protocol::endpoint _endpoint, DcpManager &manager, LogManager &logManager) : dcpManager(
             manager),
                                                                                                           endpoint(
                                                                                                                   _endpoint),
                                                                                                           connected(
                                                                                                                   false) {
-        socket = std::make_shared<asio::ip::tcp::socket>(ios);
+        socket = std::make_shared<typename Protocol::socket>(ios);
+        strand = std::make_shared<asio::io_service::strand>(ios);
         setLogManager(logManager);
     }
 
-    ~Client() {
+    ~BasicClient() {
 #if defined(DEBUG)
-        Log(TCP_CONNECTION_CLOSED, to_string(socket->remote_endpoint()));
+        Log(TCP_CONNECTION_CLOSED, ProtocolTraits<Protocol>::to_string(socket->remote_endpoint()));
 #endif
         socket->cancel();
         socket->close();
@@ -289,10 +357,11 @@ public:
         if (!connected) {
             try {
                 socket->connect(endpoint);
+                ProtocolTraits<Protocol>::prepareConnection(*socket);
 #if defined(DEBUG)
-                Log(NEW_TCP_CONNECTION_OUT, to_string(endpoint));
+                Log(NEW_TCP_CONNECTION_OUT, ProtocolTraits<Protocol>::to_string(endpoint));
 #endif
-                session = std::make_shared<Session>(socket, dcpManager);
+                session = std::make_shared<Session>(socket, dcpManager, strand);
                 session->setLogManager(logManager);
                 session->start();
                 connected = true;
@@ -300,7 +369,7 @@ public:
                 connected = false;
                 dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-                Log(NETWORK_PROBLEM, Tcp::protocolName, e.what());
+                Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
                 return false;
             }
@@ -309,7 +378,7 @@ public:
         return true;
     }
 
-    const asio::ip::tcp::endpoint &getEndpoint() const {
+    const typename Protocol::endpoint &getEndpoint() const {
         return endpoint;
     }
 
@@ -323,8 +392,9 @@ public:
 
 
 private:
-    std::shared_ptr<asio::ip::tcp::socket> socket;
-    asio::ip::tcp::endpoint endpoint;
+    std::shared_ptr<typename Protocol::socket> socket;
+    std::shared_ptr<asio::io_service::strand> strand;
+    typename Protocol::endpoint endpoint;
     DcpManager &dcpManager;
 
     bool connected;
@@ -332,4 +402,8 @@ private:
 
 };
 
+typedef BasicSession<asio::ip::tcp> Session;
+typedef BasicServer<asio::ip::tcp> Server;
+typedef BasicClient<asio::ip::tcp> Client;
+
 #endif //DCPLIB_TCPHELPER_H
@@ -13,14 +13,36 @@
 #define ASIO_STANDALONE
 
 #include <dcp/driver/ethernet/udp/helper/UdpHelper.hpp>
+#include <dcp/driver/ethernet/IoEngine.hpp>
 
 #include <dcp/driver/DcpDriver.hpp>
 
-class UdpDriver : public Logable {
+/**
+ * Driver for connectionless datagram protocols. Network information is given in the UDP_IPv4 format.
+ * @tparam Protocol asio datagram protocol, e.g. asio::ip::udp or asio::local::datagram_protocol
+ */
+template<class Protocol>
+class BasicUdpDriver : public Logable {
 public:
-    UdpDriver(std::string host, uint16_t port) : mainPort(port), mainHost(host) {}
+    typedef typename Protocol::endpoint endpoint_type;
+    //Maps the port and ip of a network information to an endpoint of Protocol
+    typedef std::function<endpoint_type(port_t, ip_address_t)> EndpointFactory;
+
+    /**
+     * @param host Host of the control socket
+     * @param port Port of the control socket
+     * @param toEndpoint Maps network information to endpoints
+     * @param batchSize Maximum number of datagrams received or sent per system call (recvmmsg/sendmmsg).
+     * 1 disables batching. Batching is only supported on Linux
+     * @param ioThreads Number of threads running the io_service. Each socket keeps the order of its PDUs,
+     * DAT_input_output PDUs of different sockets may be passed to the DcpManager concurrently,
+     * other PDUs one at a time.
+     */
+    BasicUdpDriver(std::string host, uint16_t port, EndpointFactory toEndpoint, size_t batchSize, size_t ioThreads) :
+            mainPort(port), mainHost(host), toEndpoint(toEndpoint), batchSize(batchSize),
+            ioThreads(ioThreads == 0 ? 1 : ioThreads) {}
 
-    ~UdpDriver() {}
+    ~BasicUdpDriver() {}
 
     DcpDriver getDcpDriver() {
         return {[this](DcpPdu &msg) { this->send(msg); },
@@ -39,46 +61,52 @@ public:
                 [this](paramId_t paramId, uint8_t *info) {
                     setTargetParamNetworkInformation(paramId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
                 },
-                std::bind(&UdpDriver::startReceiving, this),
-                [this](dcpId_t) {/*nothing to do for connectionless UDP_IPv4*/ },
-                [this](dcpId_t) {/*nothing to do for connectionless UDP_IPv4*/ },
+                std::bind(&BasicUdpDriver::startReceiving, this),
+                [this](dcpId_t) {/*nothing to do for connectionless protocols*/ },
+                [this](dcpId_t) {/*nothing to do for connectionless protocols*/ },
                 [this](DcpManager manager) {
-                    this->dcpManager = manager;
+                    this->dcpManager = serializeManager(manager, ioThreads);
                 },
 
                 [this](const LogManager &logManager) {
                     setLogManager(logManager);
                 },
-                std::bind(&UdpDriver::registerSuccessfull, this),
-                std::bind(&UdpDriver::openPorts, this),
-                [this]() {/*nothing to do for connectionless UDP_IPv4*/ },
-                std::bind(&UdpDriver::closeConfiguredPorts, this),
-                [this]() {/*nothing to do for connectionless UDP_IPv4*/ },
+                std::bind(&BasicUdpDriver::registerSuccessfull, this),
+                std::bind(&BasicUdpDriver::openPorts, this),
+                [this]() {/*nothing to do for connectionless protocols*/ },
+                std::bind(&BasicUdpDriver::closeConfiguredPorts, this),
+                [this]() {/*nothing to do for connectionless protocols*/ },
+                [this](DcpPdu **pdus, size_t count) { this->sendBatch(pdus, count); },
         };
     }
 
 private:
+    typedef BasicSocket<Protocol> Socket;
 
     asio::io_service io_service;
 
     DcpManager dcpManager;
     uint16_t mainPort;
     std::string mainHost;
+    EndpointFactory toEndpoint;
+    size_t batchSize;
+    size_t ioThreads;
+    std::vector<endpoint_type> batchEndpoints;
 
-    asio::ip::udp::endpoint masterEndpoint;
+    endpoint_type masterEndpoint;
     std::shared_ptr<Socket> mainSocket;
 
-    std::map<dcpId_t, asio::ip::udp::endpoint> otherSlaves;
-    std::map<dataId_t, asio::ip::udp::endpoint> ioOut;
+    std::map<dcpId_t, endpoint_type> otherSlaves;
+    std::map<dataId_t, endpoint_type> ioOut;
     std::map<dataId_t, std::shared_ptr<Socket>> ioIn;
     std::map<paramId_t, std::shared_ptr<Socket>> paramIn;
-    std::map<paramId_t, asio::ip::udp::endpoint> paramOut;
+    std::map<paramId_t, endpoint_type> paramOut;
 
     inline std::shared_ptr<Socket>
     getSocket(port_t port, ip_address_t ip) {
-        asio::ip::udp::endpoint endpoint(asio::ip::address_v4(ip), port);
+        endpoint_type endpoint = toEndpoint(port, ip);
         if (mainSocket->getEndpoint() == endpoint ||
-          (mainSocket->getEndpoint().address().to_string() == "0.0.0.0" && mainSocket->getEndpoint().port() == port)) {
+          (asio::ip::address_v4::from_string(mainHost).to_ulong() == 0 && mainPort == port)) {
             return mainSocket;
         }
         for (const auto &it : ioIn) {
@@ -91,11 +119,25 @@ private:
                 return it.second;
             }
         }
-        return std::make_shared<Socket>(io_service, endpoint, dcpManager, logManager);
+        return std::make_shared<Socket>(io_service, endpoint, dcpManager, logManager, batchSize);
     }
 
     void send(DcpPdu &msg) {
-        asio::ip::udp::endpoint endpoint;
+        mainSocket->send(msg, getEndpoint(msg));
+    }
+
+    void sendBatch(DcpPdu **pdus, size_t count) {
+        if (batchEndpoints.size() < count) {
+            batchEndpoints.resize(count);
+        }
+        for (size_t i = 0; i < count; i++) {
+            batchEndpoints[i] = getEndpoint(*pdus[i]);
+        }
+        mainSocket->sendBatch(pdus, batchEndpoints.data(), count);
+    }
+
+    inline endpoint_type getEndpoint(DcpPdu &msg) {
+        endpoint_type endpoint;
         switch (msg.getTypeId()) {
             case DcpPduType::DAT_input_output: {
                 DcpPduDatInputOutput &data = static_cast<DcpPduDatInputOutput &>(msg);
@@ -126,12 +168,11 @@ private:
                 break;
             }
         }
-        mainSocket->send(msg, endpoint);
-
+        return endpoint;
     }
 
     void setSlaveNetworkInformation(dcpId_t dcpId, port_t port, ip_address_t ip) {
-        otherSlaves[dcpId] = asio::ip::udp::endpoint(asio::ip::address_v4(ip), port);
+        otherSlaves[dcpId] = toEndpoint(port, ip);
     }
 
     void setSourceNetworkInformation(dataId_t dataId, port_t port, ip_address_t ip) {
@@ -139,7 +180,7 @@ private:
     }
 
     void setTargetNetworkInformation(dataId_t dataId, port_t port, ip_address_t ip) {
-        ioOut[dataId] = asio::ip::udp::endpoint(asio::ip::address_v4(ip), port);
+        ioOut[dataId] = toEndpoint(port, ip);
     }
 
     void setParamNetworkInformation(paramId_t paramId, port_t port, ip_address_t ip) {
@@ -147,7 +188,7 @@ private:
     }
 
     void setTargetParamNetworkInformation(paramId_t paramId, port_t port, ip_address_t ip) {
-        paramOut[paramId] = asio::ip::udp::endpoint(asio::ip::address_v4(ip), port);
+        paramOut[paramId] = toEndpoint(port, ip);
     }
 
     void startReceiving() {
@@ -157,18 +198,19 @@ private:
         for (auto &pos: paramIn) {
             pos.second->setLogManager(logManager);
         }
-        mainSocket = std::make_shared<Socket>(io_service, asio::ip::udp::endpoint(asio::ip::address_v4::from_string(mainHost), mainPort), dcpManager, logManager);
+        mainSocket = std::make_shared<Socket>(io_service,
+                                              toEndpoint(mainPort, asio::ip::address_v4::from_string(mainHost).to_ulong()),
+                                              dcpManager, logManager, batchSize);
         mainSocket->start();
-        asio::io_service::work work(io_service);
-        io_service.run();
+        runIoService(io_service, ioThreads);
     }
 
 
     void registerSuccessfull() {
         masterEndpoint = mainSocket->getLastAccess();
 #if defined(DEBUG)
-        Log(NEW_MASTER_ENDPOINT, Udp::protocolName,
-            to_string(masterEndpoint));
+        Log(NEW_MASTER_ENDPOINT, ProtocolTraits<Protocol>::name(),
+            ProtocolTraits<Protocol>::to_string(masterEndpoint));
 #endif
     }
 
@@ -196,4 +238,21 @@ private:
 
 };
 
+class UdpDriver : public BasicUdpDriver<asio::ip::udp> {
+public:
+    /**
+     * @param host Host of the control socket
+     * @param port Port of the control socket
+     * @param batchSize Maximum number of datagrams received or sent per system call (recvmmsg/sendmmsg).
+     * 1 disables batching. Batching is only supported on Linux
+     * @param ioThreads Number of threads running the io_service. Each socket keeps the order of its PDUs,
+     * DAT_input_output PDUs of different sockets may be passed to the DcpManager concurrently,
+     * other PDUs one at a time.
+     */
+    UdpDriver(std::string host, uint16_t port, size_t batchSize = 1, size_t ioThreads = 1) :
+            BasicUdpDriver(host, port, [](port_t port, ip_address_t ip) {
+                return asio::ip::udp::endpoint(asio::ip::address_v4(ip), port);
+            }, batchSize, ioThreads) {}
+};
+
 #endif //DCPLIB_UDPDRIVER_H
@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_UDPURINGDRIVER_H
+#define DCPLIB_UDPURINGDRIVER_H
+
+#include <dcp/driver/ethernet/udp/helper/UringHelper.hpp>
+
+#if defined(DCP_UDP_URING)
+
+#include <dcp/driver/DcpDriver.hpp>
+#include <dcp/driver/ethernet/ErrorCodes.hpp>
+#include <dcp/logic/Logable.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * UDP_IPv4 driver on top of io_uring (Linux 6.0 or newer).
+ * Every socket is served by one multishot recvmsg request which picks its buffers from a registered
+ * provided buffer ring, so a receive costs no system call while datagrams are arriving.
+ * Batches of PDUs are sent with one io_uring_enter call. The ports and the wire format are the same as UdpDriver.
+ */
+class UdpUringDriver : public Logable {
+public:
+    /**
+     * @param host Host of the control socket
+     * @param port Port of the control socket
+     * @param entries Number of submission queue entries of the receive and the send ring
+     * @param bufferCount Number of receive buffers shared by all sockets, a power of two
+     * @throws std::system_error if bufferCount is not a power of two
+     */
+    UdpUringDriver(std::string host, uint16_t port, unsigned entries = 256, uint16_t bufferCount = 256) :
+            mainPort(port), mainHost(host), entries(entries), bufferCount(bufferCount) {
+        //the kernel rejects a provided buffer ring of another size only when the receiving thread sets it up
+        if (bufferCount == 0 || (bufferCount & (bufferCount - 1)) != 0) {
+            throw std::system_error(EINVAL, std::system_category(),
+                                    "buffer count " + std::to_string(bufferCount) + " is not a power of two");
+        }
+    }
+
+    ~UdpUringDriver() {
+        std::unique_lock<std::mutex> lock(mtxReceiving);
+        if (receiving) {
+            lock.unlock();
+            post(Command::STOP, nullptr);
+            lock.lock();
+            receivingCV.wait(lock, [this] { return !receiving; });
+        }
+    }
+
+    DcpDriver getDcpDriver() {
+        return {[this](DcpPdu &msg) { this->send(msg); },
+                [this](dcpId_t dcpId, uint8_t *info) {
+                    setSlaveNetworkInformation(dcpId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    setSourceNetworkInformation(dataId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
+                },
+                [this](dataId_t dataId, uint8_t *info) {
+                    setTargetNetworkInformation(dataId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    setParamNetworkInformation(paramId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
+                },
+                [this](paramId_t paramId, uint8_t *info) {
+                    setTargetParamNetworkInformation(paramId, *((uint16_t *) info), *((ip_address_t *) (info + 2)));
+                },
+                std::bind(&UdpUringDriver::startReceiving, this),
+                [this](dcpId_t) {/*nothing to do for connectionless UDP_IPv4*/ },
+                [this](dcpId_t) {/*nothing to do for connectionless UDP_IPv4*/ },
+                [this](DcpManager manager) {
+                    this->dcpManager = manager;
+                },
+
+                [this](const LogManager &logManager) {
+                    setLogManager(logManager);
+                },
+                std::bind(&UdpUringDriver::registerSuccessfull, this),
+                std::bind(&UdpUringDriver::openPorts, this),
+                [this]() {/*nothing to do for connectionless UDP_IPv4*/ },
+                std::bind(&UdpUringDriver::closeConfiguredPorts, this),
+                [this]() {/*nothing to do for connectionless UDP_IPv4*/ },
+                [this](DcpPdu **pdus, size_t count) { this->sendBatch(pdus, count); },
+                //PDUs are serialized into their own buffer
+                nullptr,
+        };
+    }
+
+private:
+    enum class Command : uint8_t {
+        ARM, CANCEL, STOP
+    };
+
+    //user_data of requests which do not belong to a socket
+    static const uint64_t WAKE_TAG = 1;
+    static const uint64_t CANCEL_TAG = 2;
+    static const uint16_t BUFFER_GROUP = 0;
+    enum {
+        maxLength = 1024
+    };
+    //Each buffer starts with io_uring_recvmsg_out and the sender address, followed by the PDU
+    static const uint32_t headroom = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in);
+    static const uint32_t bufferSize = headroom + maxLength;
+
+    DcpManager dcpManager;
+    uint16_t mainPort;
+    std::string mainHost;
+    unsigned entries;
+    uint16_t bufferCount;
+
+    //Only used by the thread in startReceiving
+    IoUring receiveRing;
+    std::vector<uint8_t> buffers;
+    std::map<UringSocket *, std::shared_ptr<UringSocket>> armed;
+    uint64_t wakeValue;
+    bool stopRequested = false;
+
+    //Commands of other threads for the receiving thread, signaled via wakeFd
+    std::mutex mtxCommands;
+    std::vector<std::pair<Command, std::shared_ptr<UringSocket>>> commands;
+    int wakeFd = -1;
+
+    std::mutex mtxReceiving;
+    std::condition_variable receivingCV;
+    bool receiving = false;
+
+    std::mutex mtxSend;
+    IoUring sendRing;
+    bool fixedFile = false;
+    std::vector<msghdr> sendHeaders;
+    std::vector<iovec> sendVectors;
+    std::vector<sockaddr_in> sendAddresses;
+
+    sockaddr_in masterEndpoint;
+    std::shared_ptr<UringSocket> mainSocket;
+
+    std::map<dcpId_t, sockaddr_in> otherSlaves;
+    std::map<dataId_t, sockaddr_in> ioOut;
+    std::map<dataId_t, std::shared_ptr<UringSocket>> ioIn;
+    std::map<paramId_t, std::shared_ptr<UringSocket>> paramIn;
+    std::map<paramId_t, sockaddr_in> paramOut;
+
+    static sockaddr_in toEndpoint(ip_address_t ip, port_t port) {
+        sockaddr_in endpoint;
+        std::memset(&endpoint, 0, sizeof(endpoint));
+        endpoint.sin_family = AF_INET;
+        endpoint.sin_addr.s_addr = htonl(ip);
+        endpoint.sin_port = htons(port);
+        return endpoint;
+    }
+
+    static bool sameEndpoint(const sockaddr_in &a, const sockaddr_in &b) {
+        return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+    }
+
+    inline std::shared_ptr<UringSocket> getSocket(port_t port, ip_address_t ip) {
+        sockaddr_in endpoint = toEndpoint(ip, port);
+        if (sameEndpoint(mainSocket->endpoint, endpoint) ||
+            (mainSocket->endpoint.sin_addr.s_addr == htonl(INADDR_ANY) && mainSocket->endpoint.sin_port == endpoint.sin_port)) {
+            return mainSocket;
+        }
+        for (const auto &it : ioIn) {
+            if (sameEndpoint(it.second->endpoint, endpoint)) {
+                return it.second;
+            }
+        }
+        for (const auto &it : paramIn) {
+            if (sameEndpoint(it.second->endpoint, endpoint)) {
+                return it.second;
+            }
+        }
+        return std::make_shared<UringSocket>(endpoint);
+    }
+
+    void send(DcpPdu &msg) {
+        DcpPdu *pdu = &msg;
+        sendBatch(&pdu, 1);
+    }
+
+    /**
+     * Send PDUs from the control socket. Up to one ring of PDUs is submitted with one system call,
+     * which returns after the kernel completed them.
+     */
+    void sendBatch(DcpPdu **pdus, size_t count) {
+        std::lock_guard<std::mutex> lock(mtxSend);
+        if (!sendRing.isSetUp()) {
+            return;
+        }
+        size_t sent = 0;
+        while (sent < count) {
+            const size_t n = std::min(count - sent, sendHeaders.size());
+            for (size_t i = 0; i < n; i++) {
+                DcpPdu &msg = *pdus[sent + i];
+#if defined(DEBUG)
+                if (isLogged(PDU_SEND)) {
+                    Log(PDU_SEND, msg.to_string());
+                }
+#endif
+                sendAddresses[i] = getEndpoint(msg);
+                sendVectors[i].iov_base = msg.serializePdu();
+                sendVectors[i].iov_len = msg.getPduSize();
+                std::memset(&sendHeaders[i], 0, sizeof(msghdr));
+                sendHeaders[i].msg_name = &sendAddresses[i];
+                sendHeaders[i].msg_namelen = sizeof(sockaddr_in);
+                sendHeaders[i].msg_iov = &sendVectors[i];
+                sendHeaders[i].msg_iovlen = 1;
+
+                io_uring_sqe *sqe = sendRing.getSqe();
+                sqe->opcode = IORING_OP_SENDMSG;
+                sqe->fd = fixedFile ? 0 : mainSocket->fd;
+                sqe->flags = fixedFile ? IOSQE_FIXED_FILE : 0;
+                sqe->addr = (uint64_t) &sendHeaders[i];
+                sqe->len = 1;
+            }
+            int result = sendRing.submit((unsigned) n);
+            if (result < 0) {
+#if defined(DEBUG) || defined(LOGGING)
+                Log(NETWORK_PROBLEM, UdpUring::protocolName, std::string(strerror(-result)));
+#endif
+                dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+                return;
+            }
+            for (size_t i = 0; i < n; i++) {
+                sendRing.waitCqe();
+                int res = sendRing.peekCqe()->res;
+                sendRing.cqeSeen();
+                if (res < 0 && res != -EMSGSIZE) {
+#if defined(DEBUG) || defined(LOGGING)
+                    Log(NETWORK_PROBLEM, UdpUring::protocolName, std::string(strerror(-res)));
+#endif
+                    dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+                }
+            }
+            sent += n;
+        }
+    }
+
+    inline sockaddr_in getEndpoint(DcpPdu &msg) {
+        sockaddr_in endpoint;
+        switch (msg.getTypeId()) {
+            case DcpPduType::DAT_input_output: {
+                DcpPduDatInputOutput &data = static_cast<DcpPduDatInputOutput &>(msg);
+                endpoint = ioOut[data.getDataId()];
+                break;
+            }
+            case DcpPduType::DAT_parameter: {
+                DcpPduDatParameter &param = static_cast<DcpPduDatParameter &>(msg);
+                endpoint = paramOut[param.getParamId()];
+                break;
+            }
+            case DcpPduType::NTF_state_changed:
+            case DcpPduType::NTF_log: {
+                endpoint = masterEndpoint;
+                break;
+            }
+            case DcpPduType::RSP_ack:
+            case DcpPduType::RSP_nack:
+            case DcpPduType::RSP_state_ack:
+            case DcpPduType::RSP_error_ack:
+            case DcpPduType::RSP_log_ack: {
+                endpoint = mainSocket->lastAccess;
+                break;
+            }
+            default: {
+                DcpPduBasic &basic = static_cast<DcpPduBasic &>(msg);
+                endpoint = otherSlaves[basic.getReceiver()];
+                break;
+            }
+        }
+        return endpoint;
+    }
+
+    void setSlaveNetworkInformation(dcpId_t dcpId, port_t port, ip_address_t ip) {
+        otherSlaves[dcpId] = toEndpoint(ip, port);
+    }
+
+    void setSourceNetworkInformation(dataId_t dataId, port_t port, ip_address_t ip) {
+        ioIn[dataId] = getSocket(port, ip);
+    }
+
+    void setTargetNetworkInformation(dataId_t dataId, port_t port, ip_address_t ip) {
+        ioOut[dataId] = toEndpoint(ip, port);
+    }
+
+    void setParamNetworkInformation(paramId_t paramId, port_t port, ip_address_t ip) {
+        paramIn[paramId] = getSocket(port, ip);
+    }
+
+    void setTargetParamNetworkInformation(paramId_t paramId, port_t port, ip_address_t ip) {
+        paramOut[paramId] = toEndpoint(ip, port);
+    }
+
+    /**
+     * Set up the rings and the control socket, then serve all sockets on the calling thread until the driver
+     * is destroyed.
+     */
+    void startReceiving() {
+        {
+            std::lock_guard<std::mutex> lock(mtxReceiving);
+            receiving = true;
+        }
+        try {
+            receiveRing.setup(entries, IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN);
+            buffers.resize((size_t) bufferCount * bufferSize);
+            receiveRing.registerBufferRing(BUFFER_GROUP, buffers.data(), bufferSize, bufferCount);
+
+            sockaddr_in endpoint = toEndpoint(INADDR_ANY, mainPort);
+            if (inet_pton(AF_INET, mainHost.c_str(), &endpoint.sin_addr) != 1) {
+                throw std::system_error(EINVAL, std::system_category(), mainHost);
+            }
+            mainSocket = std::make_shared<UringSocket>(endpoint);
+            openSocket(*mainSocket);
+
+            std::lock_guard<std::mutex> lock(mtxSend);
+            sendRing.setup(entries);
+            sendHeaders.resize(sendRing.getEntries());
+            sendVectors.resize(sendRing.getEntries());
+            sendAddresses.resize(sendRing.getEntries());
+            fixedFile = sendRing.registerFiles(&mainSocket->fd, 1);
+
+            std::lock_guard<std::mutex> lockCommands(mtxCommands);
+            wakeFd = eventfd(0, EFD_CLOEXEC);
+            if (wakeFd < 0) {
+                throw std::system_error(errno, std::system_category(), "eventfd");
+            }
+        } catch (std::exception &e) {
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+            Log(NETWORK_PROBLEM, UdpUring::protocolName, e.what());
+#endif
+            finishReceiving();
+            return;
+        }
+
+        arm(mainSocket);
+        armWake();
+        processCommands();
+        receiveRing.submit();
+
+        while (!stopRequested) {
+            receiveRing.waitCqe();
+            bool buffersReturned = false;
+            bool wake = false;
+            io_uring_cqe *cqe;
+            while ((cqe = receiveRing.peekCqe()) != nullptr) {
+                const uint64_t userData = cqe->user_data;
+                const int res = cqe->res;
+                const uint32_t flags = cqe->flags;
+                receiveRing.cqeSeen();
+
+                if (userData == WAKE_TAG) {
+                    wake = true;
+                } else if (userData != CANCEL_TAG) {
+                    UringSocket *socket = (UringSocket *) userData;
+                    if (res >= 0 && (flags & IORING_CQE_F_BUFFER)) {
+                        uint16_t bid = (uint16_t) (flags >> IORING_CQE_BUFFER_SHIFT);
+                        receive(*socket, buffers.data() + (size_t) bid * bufferSize);
+                        receiveRing.addBuffer(bid);
+                        buffersReturned = true;
+                    }
+                    if (!(flags & IORING_CQE_F_MORE)) {
+                        rearmOrRelease(socket, res);
+                    }
+                }
+            }
+            if (buffersReturned) {
+                receiveRing.publishBuffers();
+            }
+            if (wake) {
+                armWake();
+                processCommands();
+            }
+            receiveRing.submit();
+        }
+
+        receiveRing.release();
+        for (auto &it : armed) {
+            close(it.second->fd);
+        }
+        armed.clear();
+        finishReceiving();
+    }
+
+    void finishReceiving() {
+        {
+            std::lock_guard<std::mutex> lock(mtxCommands);
+            if (wakeFd >= 0) {
+                close(wakeFd);
+                wakeFd = -1;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mtxReceiving);
+        receiving = false;
+        receivingCV.notify_all();
+    }
+
+    void receive(UringSocket &socket, uint8_t *buffer) {
+        io_uring_recvmsg_out *out = (io_uring_recvmsg_out *) buffer;
+        if (out->flags & MSG_TRUNC) {
+            return;
+        }
+        if (out->namelen >= sizeof(sockaddr_in)) {
+            // responses are sent to the sender of the last received PDU
+            std::memcpy(&socket.lastAccess, buffer + sizeof(io_uring_recvmsg_out), sizeof(sockaddr_in));
+        }
+        //the length indicator overwrites the tail of the sender address
+        DcpPduView pdu(buffer + headroom - PDU_LENGTH_INDICATOR_SIZE, out->payloadlen);
+#if defined(DEBUG)
+        if (isLogged(PDU_RECEIVED)) {
+            Log(PDU_RECEIVED, pdu->to_string());
+        }
+#endif
+        dcpManager.receive(*pdu);
+    }
+
+    /**
+     * The multishot request of a socket terminated. Closed sockets are released,
+     * others are rearmed if the request ran out of buffers.
+     */
+    void rearmOrRelease(UringSocket *socket, int res) {
+        if (socket->closing) {
+            close(socket->fd);
+#if defined(DEBUG)
+            Log(SOCKET_CLOSED, UdpUring::protocolName, to_string(socket->endpoint));
+#endif
+            armed.erase(socket);
+        } else if (res >= 0 || res == -ENOBUFS) {
+            arm(armed[socket]);
+        } else {
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+            Log(NETWORK_PROBLEM, UdpUring::protocolName, std::string(strerror(-res)));
+#endif
+        }
+    }
+
+    io_uring_sqe *nextSqe() {
+        io_uring_sqe *sqe = receiveRing.getSqe();
+        while (sqe == nullptr) {
+            receiveRing.submit();
+            sqe = receiveRing.getSqe();
+        }
+        return sqe;
+    }
+
+    void arm(const std::shared_ptr<UringSocket> &socket) {
+        armed[socket.get()] = socket;
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->fd = socket->fd;
+        sqe->addr = (uint64_t) &socket->msg;
+        sqe->len = 1;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = (uint64_t) socket.get();
+    }
+
+    void armWake() {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wakeFd;
+        sqe->addr = (uint64_t) &wakeValue;
+        sqe->len = sizeof(wakeValue);
+        sqe->user_data = WAKE_TAG;
+    }
+
+    void processCommands() {
+        std::vector<std::pair<Command, std::shared_ptr<UringSocket>>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mtxCommands);
+            pending.swap(commands);
+        }
+        for (auto &command : pending) {
+            switch (command.first) {
+                case Command::ARM:
+                    arm(command.second);
+                    break;
+                case Command::CANCEL: {
+                    io_uring_sqe *sqe = nextSqe();
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->addr = (uint64_t) command.second.get();
+                    sqe->user_data = CANCEL_TAG;
+                    break;
+                }
+                case Command::STOP:
+                    stopRequested = true;
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Pass a command to the receiving thread. Requests of the receive ring are only issued by that thread.
+     */
+    void post(Command command, const std::shared_ptr<UringSocket> &socket) {
+        std::lock_guard<std::mutex> lock(mtxCommands);
+        commands.emplace_back(command, socket);
+        if (wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t written = ::write(wakeFd, &one, sizeof(one));
+            (void) written;
+        }
+    }
+
+    void openSocket(UringSocket &socket) {
+        socket.fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (socket.fd < 0) {
+            throw std::system_error(errno, std::system_category(), "socket");
+        }
+        if (bind(socket.fd, (sockaddr *) &socket.endpoint, sizeof(sockaddr_in)) < 0) {
+            int error = errno;
+            close(socket.fd);
+            socket.fd = -1;
+            throw std::system_error(error, std::system_category(), "bind " + to_string(socket.endpoint));
+        }
+        socket.started = true;
+#if defined(DEBUG)
+        Log(NEW_SOCKET, UdpUring::protocolName, to_string(socket.endpoint));
+#endif
+    }
+
+    void startSocket(const std::shared_ptr<UringSocket> &socket) {
+        if (socket->started) {
+            return;
+        }
+        try {
+            openSocket(*socket);
+            post(Command::ARM, socket);
+        } catch (std::exception &e) {
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+            Log(NETWORK_PROBLEM, UdpUring::protocolName, e.what());
+#endif
+        }
+    }
+
+    void stopSocket(const std::shared_ptr<UringSocket> &socket) {
+        if (socket == mainSocket || !socket->started || socket->closing) {
+            return;
+        }
+        socket->closing = true;
+        post(Command::CANCEL, socket);
+    }
+
+    void registerSuccessfull() {
+        masterEndpoint = mainSocket->lastAccess;
+#if defined(DEBUG)
+        Log(NEW_MASTER_ENDPOINT, UdpUring::protocolName, to_string(masterEndpoint));
+#endif
+    }
+
+    void openPorts() {
+        for (auto &pos: ioIn) {
+            startSocket(pos.second);
+        }
+        for (auto &pos: paramIn) {
+            startSocket(pos.second);
+        }
+    }
+
+    void closeConfiguredPorts() {
+        for (auto &pos: ioIn) {
+            stopSocket(pos.second);
+        }
+        ioIn.clear();
+        for (auto &pos: paramIn) {
+            stopSocket(pos.second);
+        }
+        paramIn.clear();
+    }
+};
+
+#endif
+
+#endif //DCPLIB_UDPURINGDRIVER_H
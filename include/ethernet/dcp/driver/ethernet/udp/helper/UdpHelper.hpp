@@ -16,6 +16,17 @@
 #include <dcp/logic/DcpManager.hpp>
 #include <dcp/model/pdu/DcpPduFactory.hpp>
 
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && !defined(DCP_NO_MMSG)
+#define DCP_UDP_MMSG
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
 namespace Udp {
     static std::string protocolName = "UDP_IPv4";
 }
@@ -26,20 +37,81 @@ static std::string to_string(const asio::ip::udp::endpoint &remote_endpoint) {
     return oss.str();
 }
 
-class Socket : public Logable, public std::enable_shared_from_this<Socket> {
+/**
+ * Protocol specific parts of the socket helpers. Specialized for every protocol the helpers are used with.
+ */
+template<class Protocol>
+struct ProtocolTraits;
+
+template<>
+struct ProtocolTraits<asio::ip::udp> {
+    static const std::string &name() {
+        return Udp::protocolName;
+    }
+
+    static std::string to_string(const asio::ip::udp::endpoint &endpoint) {
+        return ::to_string(endpoint);
+    }
+
+    /**
+     * Called before a socket is bound to endpoint
+     * @return the endpoint to bind to
+     */
+    static const asio::ip::udp::endpoint &prepareBind(const asio::ip::udp::endpoint &endpoint) {
+        return endpoint;
+    }
+};
+
+/**
+ * Datagram socket receiving PDUs for a DcpManager.
+ * @tparam Protocol asio datagram protocol, e.g. asio::ip::udp or asio::local::datagram_protocol
+ */
+template<class Protocol>
+class BasicSocket : public Logable, public std::enable_shared_from_this<BasicSocket<Protocol>> {
 public:
+    typedef typename Protocol::endpoint endpoint_type;
 
-    Socket(asio::io_service &ios, asio::ip::udp::endpoint endpoint, DcpManager &dcpManager, LogManager &_logManager) :
-            io_service(ios), endpoint(endpoint), dcpManager(dcpManager), started(false) {
+    /**
+     * @param batchSize Maximum number of datagrams received or sent with one recvmmsg/sendmmsg call.
+     * 1 means one datagram per call. Batching is only supported on Linux
+     */
+    BasicSocket(asio::io_service &ios, endpoint_type endpoint, DcpManager &dcpManager, LogManager &_logManager,
+                size_t batchSize = 1) :
+            io_service(ios), strand(ios), endpoint(endpoint), dcpManager(dcpManager), started(false),
+            batchSize(batchSize == 0 ? 1 : batchSize) {
         setLogManager(_logManager);
+#if defined(DCP_UDP_MMSG)
+        if (this->batchSize > 1) {
+            batchData.resize(this->batchSize * batchStride);
+            receiveHeaders.resize(this->batchSize);
+            receiveVectors.resize(this->batchSize);
+            receiveAddresses.resize(this->batchSize);
+            for (size_t i = 0; i < this->batchSize; i++) {
+                receiveVectors[i].iov_base = batchData.data() + i * batchStride + PDU_LENGTH_INDICATOR_SIZE;
+                receiveVectors[i].iov_len = maxLength;
+                std::memset(&receiveHeaders[i], 0, sizeof(mmsghdr));
+                receiveHeaders[i].msg_hdr.msg_name = &receiveAddresses[i];
+                receiveHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                receiveHeaders[i].msg_hdr.msg_iov = &receiveVectors[i];
+                receiveHeaders[i].msg_hdr.msg_iovlen = 1;
+            }
+            sendHeaders.resize(this->batchSize);
+            sendVectors.resize(this->batchSize);
+        }
+#endif
     }
 
-    ~Socket() {}
+    ~BasicSocket() {}
 
-    void send(DcpPdu &msg, asio::ip::udp::endpoint endpoint) {
+    void send(DcpPdu &msg, endpoint_type endpoint) {
 #if defined(DEBUG)
-        Log(PDU_SEND, msg.to_string());
+        if (isLogged(PDU_SEND)) {
+            Log(PDU_SEND, msg.to_string());
+        }
 #endif
+        if (!fitsDatagram(msg)) {
+            return;
+        }
         std::error_code error;
         try {
             socket->send_to(
@@ -47,7 +119,7 @@ public:
                     endpoint, 0, error);
             if (error && error != asio::error::message_size) {
 #if defined(DEBUG) || defined(LOGGING)
-                Log(NETWORK_PROBLEM, Udp::protocolName, error.message());
+                Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), error.message());
 #endif
                 dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
             }
@@ -55,11 +127,70 @@ public:
             std::cerr << e.what() << std::endl;
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Udp::protocolName, e.what());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), e.what());
 #endif
         }
     }
 
+    /**
+     * Send several PDUs. With a batch size greater than 1 they are passed to the kernel with one sendmmsg
+     * call per batch. May be called from several threads, the batches are sent one after another.
+     * PDUs larger than the receive buffer are dropped.
+     * @param pdus PDUs to send
+     * @param endpoints Receiver of each PDU
+     * @param count Number of PDUs
+     */
+    void sendBatch(DcpPdu **pdus, const endpoint_type *endpoints, size_t count) {
+#if defined(DCP_UDP_MMSG)
+        if (batchSize > 1) {
+            std::lock_guard<std::mutex> lock(mtxSend);
+            size_t next = 0;
+            while (next < count) {
+                size_t n = 0;
+                for (; next < count && n < batchSize; next++) {
+                    DcpPdu &msg = *pdus[next];
+#if defined(DEBUG)
+                    if (isLogged(PDU_SEND)) {
+                        Log(PDU_SEND, msg.to_string());
+                    }
+#endif
+                    if (!fitsDatagram(msg)) {
+                        continue;
+                    }
+                    sendVectors[n].iov_base = msg.serializePdu();
+                    sendVectors[n].iov_len = msg.getPduSize();
+                    std::memset(&sendHeaders[n], 0, sizeof(mmsghdr));
+                    sendHeaders[n].msg_hdr.msg_name = (void *) endpoints[next].data();
+                    sendHeaders[n].msg_hdr.msg_namelen = (socklen_t) endpoints[next].size();
+                    sendHeaders[n].msg_hdr.msg_iov = &sendVectors[n];
+                    sendHeaders[n].msg_hdr.msg_iovlen = 1;
+                    n++;
+                }
+                size_t sent = 0;
+                while (sent < n) {
+                    int result = sendmmsg(socket->native_handle(), sendHeaders.data() + sent,
+                                          (unsigned int) (n - sent), 0);
+                    if (result < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+#if defined(DEBUG) || defined(LOGGING)
+                        Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), std::string(strerror(errno)));
+#endif
+                        dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+                        return;
+                    }
+                    sent += result;
+                }
+            }
+            return;
+        }
+#endif
+        for (size_t i = 0; i < count; i++) {
+            send(*pdus[i], endpoints[i]);
+        }
+    }
+
     void handle_receive(const std::error_code &error, std::size_t bytes_transferred) {
         if (asio::error::connection_reset == error || asio::error::operation_aborted == error ||
             asio::error::eof == error) {
@@ -70,39 +201,115 @@ public:
         if (error) {
             dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
 #if defined(DEBUG) || defined(LOGGING)
-            Log(NETWORK_PROBLEM, Udp::protocolName, error.message());
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), error.message());
 #endif
             return;
         }
 
-        DcpPdu *pdu = makeDcpPdu(data, bytes_transferred);
+        if (bytes_transferred > maxLength) {
+            //the datagram did not fit into the buffer, it was truncated
+            reportTruncated();
+            setup_receive();
+            return;
+        }
+        DcpPduView pdu(data, bytes_transferred);
 
 #if defined(DEBUG)
-        Log(PDU_RECEIVED, pdu->to_string());
+        if (isLogged(PDU_RECEIVED)) {
+            Log(PDU_RECEIVED, pdu->to_string());
+        }
 #endif
         dcpManager.receive(*pdu);
-        delete pdu;
         setup_receive();
     }
 
 
+#if defined(DCP_UDP_MMSG)
+    /**
+     * The socket is readable, drain it with recvmmsg into the receive buffers.
+     */
+    void handle_receive_batch(const std::error_code &error) {
+        if (asio::error::connection_reset == error || asio::error::operation_aborted == error ||
+            asio::error::eof == error) {
+            //Socket is closed => stop receiving
+            return;
+        }
+
+        if (error) {
+            dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+            Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), error.message());
+#endif
+            return;
+        }
+
+        for (;;) {
+            int received = recvmmsg(socket->native_handle(), receiveHeaders.data(), (unsigned int) batchSize,
+                                    MSG_DONTWAIT, nullptr);
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+                    Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(), std::string(strerror(errno)));
+#endif
+                }
+                break;
+            }
+            for (int i = 0; i < received; i++) {
+                mmsghdr &header = receiveHeaders[i];
+                // responses are sent to the sender of the last received PDU
+                std::memcpy(lastAccess.data(), &receiveAddresses[i], header.msg_hdr.msg_namelen);
+                lastAccess.resize(header.msg_hdr.msg_namelen);
+                header.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                if (header.msg_hdr.msg_flags & MSG_TRUNC) {
+                    reportTruncated();
+                    continue;
+                }
+
+                DcpPduView pdu(batchData.data() + i * batchStride, header.msg_len);
+#if defined(DEBUG)
+                if (isLogged(PDU_RECEIVED)) {
+                    Log(PDU_RECEIVED, pdu->to_string());
+                }
+#endif
+                dcpManager.receive(*pdu);
+            }
+            if ((size_t) received < batchSize) {
+                break;
+            }
+        }
+        setup_receive();
+    }
+#endif
+
     void setup_receive() {
-        socket->async_receive_from(asio::buffer(data + 4, maxLength), lastAccess,
-                                   std::bind(&Socket::handle_receive, this,
-                                             std::placeholders::_1,
-                                             std::placeholders::_2));
+#if defined(DCP_UDP_MMSG)
+        if (batchSize > 1) {
+            socket->async_wait(Protocol::socket::wait_read,
+                               strand.wrap(std::bind(&BasicSocket::handle_receive_batch, this, std::placeholders::_1)));
+            return;
+        }
+#endif
+        socket->async_receive_from(asio::buffer(data + 4, maxLength + 1), lastAccess,
+                                   strand.wrap(std::bind(&BasicSocket::handle_receive, this,
+                                                         std::placeholders::_1,
+                                                         std::placeholders::_2)));
     }
 
-    const asio::ip::udp::endpoint &getLastAccess() const {
+    const endpoint_type &getLastAccess() const {
         return lastAccess;
     }
 
     void start() {
         if(!started){
-            socket = std::unique_ptr<asio::ip::udp::socket>(new asio::ip::udp::socket(io_service, endpoint));
+            socket = std::unique_ptr<typename Protocol::socket>(
+                    new typename Protocol::socket(io_service, ProtocolTraits<Protocol>::prepareBind(endpoint)));
             setup_receive();
 #if defined(DEBUG)
-            Log(NEW_SOCKET, Udp::protocolName, to_string(endpoint));
+            Log(NEW_SOCKET, ProtocolTraits<Protocol>::name(), ProtocolTraits<Protocol>::to_string(endpoint));
 #endif
             started = true;
         }
@@ -111,30 +318,72 @@ public:
 
     void close() {
         //one in asio queue, one existing in driver
-        if(shared_from_this().use_count() == 2){
+        if(this->shared_from_this().use_count() == 2){
             socket->close();
 #if defined(DEBUG)
-            Log(SOCKET_CLOSED, Udp::protocolName, to_string(endpoint));
+            Log(SOCKET_CLOSED, ProtocolTraits<Protocol>::name(), ProtocolTraits<Protocol>::to_string(endpoint));
 #endif
         }
     }
 
-    const asio::ip::udp::endpoint &getEndpoint() const {
+    const endpoint_type &getEndpoint() const {
         return endpoint;
     }
 
 private:
+    /**
+     * The receiver truncates datagrams larger than its buffer, such PDUs are not sent.
+     */
+    bool fitsDatagram(DcpPdu &msg) {
+        if (msg.getPduSize() <= maxLength) {
+            return true;
+        }
+        dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+        Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(),
+            "PDU of " + std::to_string(msg.getPduSize()) + " bytes exceeds the maximum datagram size of " +
+            std::to_string((size_t) maxLength) + " bytes");
+#endif
+        return false;
+    }
+
+    void reportTruncated() {
+        dcpManager.reportError(DcpError::PROTOCOL_ERROR_GENERIC);
+#if defined(DEBUG) || defined(LOGGING)
+        Log(NETWORK_PROBLEM, ProtocolTraits<Protocol>::name(),
+            "Received a datagram larger than " + std::to_string((size_t) maxLength) + " bytes, it is dropped");
+#endif
+    }
+
     asio::io_service &io_service;
-    asio::ip::udp::endpoint endpoint;
-    std::unique_ptr<asio::ip::udp::socket> socket;
+    //Serializes the receive handlers of this socket if the io_service runs on multiple threads
+    asio::io_service::strand strand;
+    endpoint_type endpoint;
+    std::unique_ptr<typename Protocol::socket> socket;
     DcpManager dcpManager;
-    asio::ip::udp::endpoint lastAccess;
+    endpoint_type lastAccess;
     enum {
         maxLength = 1024
     };
-    uint8_t data[maxLength];
+    //one byte more than the largest PDU, so truncated datagrams are detected
+    uint8_t data[maxLength + 1 + PDU_LENGTH_INDICATOR_SIZE];
     bool started;
+    size_t batchSize;
+#if defined(DCP_UDP_MMSG)
+    static const size_t batchStride = maxLength + PDU_LENGTH_INDICATOR_SIZE;
+    //Receive buffers, one per datagram of a batch, each with room for the length indicator
+    std::vector<uint8_t> batchData;
+    std::vector<mmsghdr> receiveHeaders;
+    std::vector<iovec> receiveVectors;
+    std::vector<sockaddr_storage> receiveAddresses;
+    //Guards the send headers, which are shared by all threads calling sendBatch
+    std::mutex mtxSend;
+    std::vector<mmsghdr> sendHeaders;
+    std::vector<iovec> sendVectors;
+#endif
 
 };
 
+typedef BasicSocket<asio::ip::udp> Socket;
+
 #endif //DCPLIB_UDPHELPER_H
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_URINGHELPER_H
+#define DCPLIB_URINGHELPER_H
+
+#if defined(__linux__) && defined(__has_include) && !defined(DCP_NO_URING)
+#if __has_include(<linux/io_uring.h>)
+#define DCP_UDP_URING
+#endif
+#endif
+
+#if defined(DCP_UDP_URING)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+namespace UdpUring {
+    static std::string protocolName = "UDP_IPv4";
+}
+
+static std::string to_string(const sockaddr_in &address) {
+    char host[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &address.sin_addr, host, sizeof(host));
+    std::ostringstream oss;
+    oss << host << ":" << ntohs(address.sin_port);
+    return oss.str();
+}
+
+/**
+ * Minimal io_uring instance, driven by the raw system calls.
+ * The submission queue must only be used by one thread at a time, the same applies to the completion queue.
+ */
+class IoUring {
+public:
+    IoUring() {}
+
+    ~IoUring() {
+        release();
+    }
+
+    IoUring(const IoUring &) = delete;
+
+    IoUring &operator=(const IoUring &) = delete;
+
+    /**
+     * Create the ring and map its queues.
+     * @param entries Number of submission queue entries
+     * @param flags IORING_SETUP_* flags. If the kernel rejects them, the ring is created without flags.
+     * @throws std::system_error if the ring can not be created
+     */
+    void setup(unsigned entries, unsigned flags = 0) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        params.flags = flags;
+        fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0 && errno == EINVAL && flags != 0) {
+            std::memset(&params, 0, sizeof(params));
+            fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+        }
+        if (fd < 0) {
+            throw std::system_error(errno, std::system_category(), "io_uring_setup");
+        }
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        sqRing = map(sqRingSize, IORING_OFF_SQ_RING);
+        cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing : map(cqRingSize, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = (io_uring_sqe *) map(sqesSize, IORING_OFF_SQES);
+
+        sqHead = (unsigned *) (sqRing + params.sq_off.head);
+        sqTail = (unsigned *) (sqRing + params.sq_off.tail);
+        sqMask = *(unsigned *) (sqRing + params.sq_off.ring_mask);
+        sqArray = (unsigned *) (sqRing + params.sq_off.array);
+        cqHead = (unsigned *) (cqRing + params.cq_off.head);
+        cqTail = (unsigned *) (cqRing + params.cq_off.tail);
+        cqMask = *(unsigned *) (cqRing + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe *) (cqRing + params.cq_off.cqes);
+        sqEntries = params.sq_entries;
+        sqeTail = *sqTail;
+    }
+
+    /**
+     * @return the next free submission queue entry, cleared, or nullptr if the queue is full
+     */
+    io_uring_sqe *getSqe() {
+        if (sqeTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            return nullptr;
+        }
+        io_uring_sqe *sqe = &sqes[sqeTail & sqMask];
+        sqArray[sqeTail & sqMask] = sqeTail & sqMask;
+        sqeTail++;
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        return sqe;
+    }
+
+    /**
+     * Pass all prepared entries to the kernel with one system call.
+     * @param waitNr Number of completions to wait for
+     * @return number of submitted entries or -errno
+     */
+    int submit(unsigned waitNr = 0) {
+        __atomic_store_n(sqTail, sqeTail, __ATOMIC_RELEASE);
+        for (;;) {
+            unsigned pending = sqeTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            int result = (int) syscall(__NR_io_uring_enter, fd, pending, waitNr,
+                                       waitNr > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            return result < 0 ? -errno : result;
+        }
+    }
+
+    /**
+     * Block until at least one completion is available. Does not submit.
+     */
+    void waitCqe() {
+        while (peekCqe() == nullptr) {
+            syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        }
+    }
+
+    /**
+     * @return the oldest unconsumed completion or nullptr
+     */
+    io_uring_cqe *peekCqe() {
+        unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            return nullptr;
+        }
+        return &cqes[head & cqMask];
+    }
+
+    /**
+     * Mark the completion returned by peekCqe as consumed.
+     */
+    void cqeSeen() {
+        __atomic_store_n(cqHead, *cqHead + 1, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * Register a ring of provided buffers the kernel selects receive buffers from.
+     * @param group Buffer group id used by IOSQE_BUFFER_SELECT
+     * @param base Memory of count * bufferSize bytes
+     * @param bufferSize Size of one buffer
+     * @param count Number of buffers, a power of two
+     * @throws std::system_error if the kernel does not support provided buffer rings
+     */
+    void registerBufferRing(uint16_t group, uint8_t *base, uint32_t bufferSize, uint16_t count) {
+        bufRingSize = count * sizeof(io_uring_buf);
+        bufRing = (io_uring_buf_ring *) mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE,
+                                             MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (bufRing == MAP_FAILED) {
+            bufRing = nullptr;
+            throw std::system_error(errno, std::system_category(), "mmap");
+        }
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = (uint64_t) bufRing;
+        reg.ring_entries = count;
+        reg.bgid = group;
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            throw std::system_error(errno, std::system_category(), "IORING_REGISTER_PBUF_RING");
+        }
+        bufBase = base;
+        bufSize = bufferSize;
+        bufMask = count - 1;
+        bufTail = 0;
+        for (uint16_t bid = 0; bid < count; bid++) {
+            addBuffer(bid);
+        }
+        publishBuffers();
+    }
+
+    /**
+     * Hand a provided buffer back to the kernel. Becomes visible with publishBuffers.
+     * @param bid Id of the buffer
+     */
+    void addBuffer(uint16_t bid) {
+        //not bufRing->bufs, C++ compilers place the flexible array of the kernel header behind an empty member
+        io_uring_buf &buf = ((io_uring_buf *) bufRing)[bufTail & bufMask];
+        buf.addr = (uint64_t) (bufBase + (size_t) bid * bufSize);
+        buf.len = bufSize;
+        buf.bid = bid;
+        bufTail++;
+    }
+
+    void publishBuffers() {
+        __atomic_store_n(&bufRing->tail, bufTail, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * Register file descriptors, so entries can refer to them by index with IOSQE_FIXED_FILE.
+     * @return true if the kernel accepted the files
+     */
+    bool registerFiles(const int *fds, unsigned count) {
+        return syscall(__NR_io_uring_register, fd, IORING_REGISTER_FILES, fds, count) == 0;
+    }
+
+    unsigned getEntries() const {
+        return sqEntries;
+    }
+
+    bool isSetUp() const {
+        return fd >= 0;
+    }
+
+    void release() {
+        if (fd < 0) {
+            return;
+        }
+        close(fd);
+        fd = -1;
+        if (bufRing != nullptr) {
+            munmap(bufRing, bufRingSize);
+            bufRing = nullptr;
+        }
+        munmap(sqes, sqesSize);
+        if (cqRing != sqRing) {
+            munmap(cqRing, cqRingSize);
+        }
+        munmap(sqRing, sqRingSize);
+    }
+
+private:
+    int fd = -1;
+
+    uint8_t *sqRing = nullptr;
+    uint8_t *cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    //Tail of the entries handed out by getSqe, published to the kernel on submit
+    unsigned sqeTail = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    io_uring_buf_ring *bufRing = nullptr;
+    size_t bufRingSize = 0;
+    uint8_t *bufBase = nullptr;
+    uint32_t bufSize = 0;
+    uint16_t bufMask = 0;
+    uint16_t bufTail = 0;
+
+    uint8_t *map(size_t size, off_t offset) {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+        if (ptr == MAP_FAILED) {
+            throw std::system_error(errno, std::system_category(), "mmap");
+        }
+        return (uint8_t *) ptr;
+    }
+};
+
+/**
+ * UDP socket whose datagrams are received by one multishot recvmsg request.
+ */
+struct UringSocket {
+    UringSocket(const sockaddr_in &endpoint) : endpoint(endpoint) {
+        std::memset(&lastAccess, 0, sizeof(lastAccess));
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int fd = -1;
+    sockaddr_in endpoint;
+    //Sender of the last received PDU
+    sockaddr_in lastAccess;
+    //Template for the multishot recvmsg, must stay valid while the request is armed
+    msghdr msg;
+    bool started = false;
+    bool closing = false;
+};
+
+#endif
+
+#endif //DCPLIB_URINGHELPER_H
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019, FG Simulation und Modellierung, Leibniz Universitt Hannover, Germany
+ *
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms
+ * of the BSD 3-CLause license.  See the LICENSE file for details.
+ */
+
+#ifndef DCPLIB_DCPLISTENERDISPATCHER_HPP
+#define DCPLIB_DCPLISTENERDISPATCHER_HPP
+
+#include <dcp/logic/DcpCallbackExecutor.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * Defines where listeners of a master, which are not registered as SYNC, are executed.
+ */
+enum class DcpDispatchMode : uint8_t {
+    /** On the thread which received the PDU */
+    INLINE,
+    /** On one worker thread, all listeners are executed in order of reception */
+    SERIAL,
+    /** On a pool of worker threads. Listeners with the same ordering key are executed in order of reception */
+    POOL
+};
+
+/**
+ * Executes listeners of a master. Each worker has its own queue, a task is assigned to the worker
+ * by its ordering key (e.g. the sender of a PDU), so tasks with the same key keep their order.
+ * If the queue of a worker is full, the submitting thread waits until there is space again.
+ */
+class DcpListenerDispatcher {
+public:
+    /**
+     * @param mode Dispatching mode
+     * @param workers Number of worker threads in mode POOL
+     * @param capacity Maximum number of pending tasks per worker
+     * @param cpus CPUs the workers are pinned to, worker i is pinned to cpus[i % cpus.size()]. Empty means no pinning
+     */
+    explicit DcpListenerDispatcher(DcpDispatchMode mode = DcpDispatchMode::POOL, size_t workers = 2,
+                                   size_t capacity = 1024, const std::vector<int> &cpus = {}) : mode(mode) {
+        size_t lanes = 0;
+        switch (mode) {
+            case DcpDispatchMode::INLINE:
+                lanes = 0;
+                break;
+            case DcpDispatchMode::SERIAL:
+                lanes = 1;
+                break;
+            case DcpDispatchMode::POOL:
+                lanes = workers == 0 ? 1 : workers;
+                break;
+        }
+        for (size_t i = 0; i < lanes; i++) {
+            std::vector<int> laneCpus;
+            if (!cpus.empty()) {
+                laneCpus.push_back(cpus[i % cpus.size()]);
+            }
+            executors.push_back(new DcpCallbackExecutor(1, capacity, laneCpus));
+        }
+    }
+
+    /**
+     * Executes all pending tasks and joins the workers
+     */
+    ~DcpListenerDispatcher() {
+        for (DcpCallbackExecutor *executor : executors) {
+            delete executor;
+        }
+    }
+
+    DcpListenerDispatcher(const DcpListenerDispatcher &) = delete;
+
+    DcpListenerDispatcher &operator=(const DcpListenerDispatcher &) = delete;
+
+    /**
+     * Execute a task
+     * @param key Ordering key, tasks with the same key are executed in order of submission
+     * @param task Task to execute
+     */
+    void dispatch(uint64_t key, std::function<void()> &&task) {
+        dispatched.fetch_add(1, std::memory_order_relaxed);
+        if (executors.empty()) {
+            task();
+            return;
+        }
+        DcpCallbackExecutor &executor = *executors[key % executors.size()];
+        if (!executor.execute(std::move(task))) {
+            stalls.fetch_add(1, std::memory_order_relaxed);
+            do {
+                std::this_thread::yield();
+            } while (!executor.execute(std::move(task)));
+        }
+        const size_t depth = executor.getQueueDepth();
+        size_t max = maxQueueDepth.load(std::memory_order_relaxed);
+        while (depth > max && !maxQueueDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {}
+    }
+
+    inline DcpDispatchMode getMode() const {
+        return mode;
+    }
+
+    /**
+     * @return Number of worker threads, 0 in mode INLINE
+     */
+    inline size_t getWorkerCount() const {
+        return executors.size();
+    }
+
+    /**
+     * @param worker Index of the worker
+     * @return Number of tasks waiting for the worker
+     */
+    inline size_t getQueueDepth(size_t worker) const {
+        return executors[worker]->getQueueDepth();
+    }
+
+    /**
+     * @return Number of tasks waiting for any worker
+     */
+    size_t getQueueDepth() const {
+        size_t depth = 0;
+        for (const DcpCallbackExecutor *executor : executors) {
+            depth += executor->getQueueDepth();
+        }
+        return depth;
+    }
+
+    /**
+     * @return Highest number of tasks observed waiting for a single worker
+     */
+    inline size_t getMaxQueueDepth() const {
+        return maxQueueDepth.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Number of dispatched tasks
+     */
+    inline uint64_t getDispatchedCount() const {
+        return dispatched.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Number of submissions which had to wait for a full queue
+     */
+    inline uint64_t getStallCount() const {
+        return stalls.load(std::memory_order_relaxed);
+    }
+
+private:
+    const DcpDispatchMode mode;
+    std::vector<DcpCallbackExecutor *> executors;
+    std::atomic<size_t> maxQueueDepth{0};
+    std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> stalls{0};
+};
+
+#endif //DCPLIB_DCPLISTENERDISPATCHER_HPP
@@ -10,8 +10,10 @@
 #ifndef ACI_LOGIC_DRIVERMANAGERMASTER_H_
 #define ACI_LOGIC_DRIVERMANAGERMASTER_H_
 
+#include <cassert>
 #include <cstdint>
 #include <condition_variable>
+#include <vector>
 
 #include <dcp/model/pdu/DcpPdu.hpp>
 #include <dcp/model/pdu/DcpPduBasic.hpp>
@@ -39,6 +41,7 @@
 #include <dcp/model/pdu/DcpPduStcRegister.hpp>
 #include <dcp/model/pdu/DcpPduStcRun.hpp>
 #include <dcp/model/DcpCallbackTypes.hpp>
+#include <dcp/logic/DcpListenerDispatcher.hpp>
 
 #include "dcp/logic/AbstractDcpManager.hpp"
 #include "dcp/model/LogEntry.hpp"
@@ -70,7 +73,39 @@ public:
         this->masterId = 0;
     }
 
-    virtual ~DcpManagerMaster() {}
+    /**
+     * Create the sequence id entries of slaves, data ids and param ids up front. Entries are otherwise created
+     * on first use, which grows the tables. Call it before start() if PDUs are received on several threads
+     * or sent from other threads than the receiving one.
+     * @param dcpIds Dcp ids of all slaves
+     * @param dataIds Data ids of all inputs and outputs
+     * @param paramIds Param ids of all tunable parameters
+     */
+    void reserveSequenceIds(const std::vector<uint8_t> &dcpIds, const std::vector<uint16_t> &dataIds,
+                            const std::vector<uint16_t> &paramIds) {
+        for (uint8_t id : dcpIds) {
+            segNumsOut.reserve(id);
+            segNumsIn.reserve(id);
+            //reset on CFG_clear by dcp id
+            dataSegNumsOut.reserve(id);
+            dataSegNumsIn.reserve(id);
+        }
+        for (uint16_t id : dataIds) {
+            dataSegNumsOut.reserve(id);
+            dataSegNumsIn.reserve(id);
+        }
+        for (uint16_t id : paramIds) {
+            parameterSegNumsOut.reserve(id);
+            parameterSegNumsIn.reserve(id);
+        }
+    }
+
+    virtual ~DcpManagerMaster() {
+#if defined(DEBUG) || defined(LOGGING)
+        logRing.stop();
+#endif
+        delete listenerDispatcher;
+    }
 
     virtual void receive(DcpPdu &msg) override {
         //check sequence id
@@ -85,8 +120,7 @@ public:
                     if (synchronousCallback[DcpCallbackTypes::PDU_MISSED]) {
                         pduMissedListener(pdu.getSender());
                     } else {
-                        std::thread t(pduMissedListener, pdu.getSender());
-                        t.detach();
+                        listenerDispatcher->dispatch(pdu.getSender(), std::bind(pduMissedListener, pdu.getSender()));
                     }
                 }
                 break;
@@ -97,8 +131,8 @@ public:
                     if (synchronousCallback[DcpCallbackTypes::PDU_MISSED]) {
                         inputOutputPduMissedListener(data.getDataId());
                     } else {
-                        std::thread t(inputOutputPduMissedListener, data.getDataId());
-                        t.detach();
+                        listenerDispatcher->dispatch(data.getDataId(),
+                                                     std::bind(inputOutputPduMissedListener, data.getDataId()));
                     }
                 }
                 break;
@@ -113,18 +147,18 @@ public:
                     lastRegisterSuccessfullSeq[ack.getSender()] = ack.getRespSeqId();
                 }
                 if(lastClearSeq[ack.getSender()] == ack.getRespSeqId()){
-                    segNumsOut[ack.getSender()] = lastRegisterSuccessfullSeq[ack.getSender()] + 1;
-                    segNumsIn[ack.getSender()] = lastRegisterSuccessfullSeq[ack.getSender()] + 1;
-                    dataSegNumsOut[ack.getSender()] = 0;
-                    dataSegNumsIn[ack.getSender()] = 0;
+                    segNumsOut[ack.getSender()].seqId = lastRegisterSuccessfullSeq[ack.getSender()] + 1;
+                    segNumsIn[ack.getSender()].seqId = lastRegisterSuccessfullSeq[ack.getSender()] + 1;
+                    dataSegNumsOut[ack.getSender()].seqId = 0;
+                    dataSegNumsIn[ack.getSender()].seqId = 0;
                     lastRegisterSeq[ack.getSender()] = 0;
                     lastClearSeq[ack.getSender()] = 0;
                 }
                 if (synchronousCallback[DcpCallbackTypes::ACK]) {
                     ackReceivedListener(ack.getSender(), ack.getRespSeqId());
                 } else {
-                    std::thread t(ackReceivedListener, ack.getSender(), ack.getRespSeqId());
-                    t.detach();
+                    listenerDispatcher->dispatch(ack.getSender(),
+                                                 std::bind(ackReceivedListener, ack.getSender(), ack.getRespSeqId()));
                 }
                 break;
             }
@@ -134,9 +168,9 @@ public:
                     nAckReceivedListener(nack.getSender(), nack.getRespSeqId(),
                                          nack.getErrorCode());
                 } else {
-                    std::thread t(nAckReceivedListener, nack.getSender(), nack.getRespSeqId(),
-                                  nack.getErrorCode());
-                    t.detach();
+                    listenerDispatcher->dispatch(nack.getSender(),
+                                                 std::bind(nAckReceivedListener, nack.getSender(),
+                                                           nack.getRespSeqId(), nack.getErrorCode()));
                 }
                 break;
             }
@@ -146,9 +180,9 @@ public:
                     stateAckReceivedListener(stateAck.getSender(),
                                              stateAck.getRespSeqId(), stateAck.getStateId());
                 } else {
-                    std::thread t(stateAckReceivedListener, stateAck.getSender(),
-                                  stateAck.getRespSeqId(), stateAck.getStateId());
-                    t.detach();
+                    listenerDispatcher->dispatch(stateAck.getSender(),
+                                                 std::bind(stateAckReceivedListener, stateAck.getSender(),
+                                                           stateAck.getRespSeqId(), stateAck.getStateId()));
                 }
                 break;
             }
@@ -159,9 +193,9 @@ public:
                     errorAckReceivedListener(errorAck.getSender(),
                                              errorAck.getRespSeqId(), errorAck.getErrorCode());
                 } else {
-                    std::thread t(errorAckReceivedListener, errorAck.getSender(),
-                                  errorAck.getRespSeqId(), errorAck.getErrorCode());
-                    t.detach();
+                    listenerDispatcher->dispatch(errorAck.getSender(),
+                                                 std::bind(errorAckReceivedListener, errorAck.getSender(),
+                                                           errorAck.getRespSeqId(), errorAck.getErrorCode()));
                 }
                 break;
             }
@@ -194,8 +228,9 @@ public:
                     if (synchronousCallback[DcpCallbackTypes::RSP_log_ack]) {
                         logAckListener(logAck.getSender(), logAck.getRespSeqId(), entries);
                     } else {
-                        std::thread t(logAckListener, logAck.getSender(), logAck.getRespSeqId(), entries);
-                        t.detach();
+                        listenerDispatcher->dispatch(logAck.getSender(),
+                                                     std::bind(logAckListener, logAck.getSender(),
+                                                               logAck.getRespSeqId(), entries));
                     }
                 }
                 break;
@@ -207,9 +242,9 @@ public:
                     stateChangedNotificationReceivedListener(stateChanged.getSender(),
                                                              stateChanged.getStateId());
                 } else {
-                    std::thread t(stateChangedNotificationReceivedListener, stateChanged.getSender(),
-                                  stateChanged.getStateId());
-                    t.detach();
+                    listenerDispatcher->dispatch(stateChanged.getSender(),
+                                                 std::bind(stateChangedNotificationReceivedListener, stateChanged.getSender(),
+                                                           stateChanged.getStateId()));
                 }
                 break;
             }
@@ -231,8 +266,9 @@ public:
                         if (synchronousCallback[DcpCallbackTypes::NTF_LOG]) {
                             logNotificationListener(log.getSender(), sharedPtr);
                         } else {
-                            std::thread t(logNotificationListener, log.getSender(), sharedPtr);
-                            t.detach();
+                            listenerDispatcher->dispatch(log.getSender(),
+                                                         std::bind(logNotificationListener, log.getSender(),
+                                                                   sharedPtr));
                         }
                     } else {
                         break;
@@ -245,9 +281,20 @@ public:
                 DcpPduDatInputOutput &data = static_cast<DcpPduDatInputOutput &>(msg);
                 if (synchronousCallback[DcpCallbackTypes::NACK]) {
                     dataReceivedListener(data.getDataId(), data.getSerializedSize(), data.getPayload());
+                } else if (listenerDispatcher->getMode() == DcpDispatchMode::INLINE) {
+                    dataReceivedListener(data.getDataId(), data.getSerializedSize(), data.getPayload());
                 } else {
-                    std::thread t(dataReceivedListener, data.getDataId(), data.getSerializedSize(), data.getPayload());
-                    t.detach();
+                    // the received PDU is only valid during receive, the worker gets a copy of the whole PDU.
+                    // Like in the synchronous case the listener gets the serialized size as length, the copy is
+                    // padded by the header size so reading length bytes from the payload stays within it
+                    const uint16_t dataId = data.getDataId();
+                    const size_t size = data.getSerializedSize();
+                    const size_t header = data.getPayload() - data.serialize();
+                    std::shared_ptr<std::vector<uint8_t>> pdu = std::make_shared<std::vector<uint8_t>>(size + header, 0);
+                    memcpy(pdu->data(), data.serialize(), size);
+                    listenerDispatcher->dispatch(dataId, [this, dataId, size, header, pdu] {
+                        dataReceivedListener(dataId, size, pdu->data() + header);
+                    });
                 }
                 break;
             }
@@ -259,8 +306,7 @@ public:
         if (synchronousCallback[DcpCallbackTypes::ERROR_LI]) {
             errorListener(errorCode);
         } else {
-            std::thread t(errorListener, errorCode);
-            t.detach();
+            listenerDispatcher->dispatch(0, std::bind(errorListener, errorCode));
         }
     }
 
@@ -706,7 +752,7 @@ public:
     * @pre setTargetNetworkInformation of the given DcpDriver was called for dcpId before
     */
     void DAT_input_output(const uint16_t dataId, uint8_t *configuration, size_t configurationLength) {
-        DcpPduDatInputOutput data = {getNextParameterSeqNum(dataId), dataId, configuration, configurationLength};
+        DcpPduDatInputOutput data = {getNextDataSeqNum(dataId), dataId, configuration, configurationLength};
         driver.send(data);
     }
 
@@ -851,7 +897,8 @@ public:
     }
 
     /**
-     * Set the listener for DAT_input_output PDUs
+     * Set the listener for DAT_input_output PDUs. If the driver receives on several threads, a SYNC or INLINE
+     * listener is called concurrently for PDUs of different sockets.
      * @tparam ftype SYNC means calling the given function is blocking, ASYNC means non blocking
      * @param dataReceivedListener function which will be called after the event occurs
      */
@@ -889,6 +936,29 @@ public:
         DcpManagerMaster::pduListener = std::move(pduListener);
     }
 
+    /**
+     * Set how listeners, which are not registered as SYNC, are executed. Listeners for PDUs of the same slave
+     * (for DAT_input_output of the same data id) are executed in order of reception in each mode.
+     * Must be called before start(), the old dispatcher may still be executing listeners afterwards.
+     * @param mode INLINE, SERIAL or POOL
+     * @param workers number of worker threads in mode POOL
+     * @param cpus CPUs the workers are pinned to. Empty means no pinning
+     * @param capacity maximum number of pending listeners per worker
+     */
+    void setListenerDispatcher(DcpDispatchMode mode, size_t workers = 2, const std::vector<int> &cpus = {},
+                               size_t capacity = 1024) {
+        assert(!started && "setListenerDispatcher must be called before start()");
+        delete listenerDispatcher;
+        listenerDispatcher = new DcpListenerDispatcher(mode, workers, capacity, cpus);
+    }
+
+    /**
+     * @return Dispatcher of the listeners, e.g. to read its queue depth
+     */
+    const DcpListenerDispatcher &getListenerDispatcher() const {
+        return *listenerDispatcher;
+    }
+
     DcpManager getDcpManager() override {
         return {[this](DcpPdu &msg) { receive(msg); },
                 [this](const DcpError errorCode) { reportError(errorCode); }};
@@ -901,11 +971,13 @@ private:
     std::map<uint8_t, std::condition_variable> heartbeatCV;
     std::map<uint8_t, std::mutex> heartbeatMutex;
 
-    std::map<uint8_t, uint16_t> lastRegisterSeq;
-    std::map<uint8_t, uint16_t> lastRegisterSuccessfullSeq;
-    std::map<uint8_t, uint16_t> lastClearSeq;
+    //by dcp id of the slave
+    uint16_t lastRegisterSeq[256] = {};
+    uint16_t lastRegisterSuccessfullSeq[256] = {};
+    uint16_t lastClearSeq[256] = {};
 
     std::map<DcpCallbackTypes, bool> synchronousCallback;
+    DcpListenerDispatcher *listenerDispatcher = new DcpListenerDispatcher();
     std::function<void(uint8_t sender, uint16_t pduSeqId)> ackReceivedListener = [](uint8_t sender,
                                                                                     uint16_t pduSeqId) {};
     std::function<void(uint8_t sender, uint16_t pduSeqId,
@@ -936,15 +1008,11 @@ private:
 
     std::map<dcpId_t, std::map<logTemplateId_t, LogTemplate>> logTemplates;
 
-    const LogTemplate SENDING_HEARTBEAT_STARTED = LogTemplate(160, LogCategory::DCP_LIB_MASTER,
-                                                              DcpLogLevel::LVL_INFORMATION,
-                                                              "Start sending heartbeat to slave id %uint8 every %uint32 / %uint32s.",
-                                                              {DcpDataType::uint8, DcpDataType::uint32,
-                                                               DcpDataType::uint32});
-    const LogTemplate SENDING_HEARTBEAT_STOPPED = LogTemplate(161, LogCategory::DCP_LIB_MASTER,
-                                                              DcpLogLevel::LVL_INFORMATION,
-                                                              "Stop sending heartbeat to slave id %uint8.",
-                                                              {DcpDataType::uint8});
+    const LogDescriptor<LogCategory::DCP_LIB_MASTER, DcpLogLevel::LVL_INFORMATION, DcpDataType::uint8,
+            DcpDataType::uint32, DcpDataType::uint32>
+            SENDING_HEARTBEAT_STARTED{160, "Start sending heartbeat to slave id %uint8 every %uint32 / %uint32s."};
+    const LogDescriptor<LogCategory::DCP_LIB_MASTER, DcpLogLevel::LVL_INFORMATION, DcpDataType::uint8>
+            SENDING_HEARTBEAT_STOPPED{161, "Stop sending heartbeat to slave id %uint8."};
 
 
     void heartBeatRoutine(const uint8_t dcpId, const uint32_t numerator, const uint32_t denominator) {
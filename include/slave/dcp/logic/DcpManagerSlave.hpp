@@ -9,11 +9,14 @@
 
 #ifndef ACOSAR_DRIVERMANAGERSLAVE_H
 #define ACOSAR_DRIVERMANAGERSLAVE_H
+#include <cassert>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 
 #include "dcp/logic/AbstractDcpManagerSlave.hpp"
 #include <dcp/model/DcpCallbackTypes.hpp>
+#include <dcp/logic/DcpCallbackExecutor.hpp>
 
 
 
@@ -35,10 +38,17 @@ public:
     }
 
     ~DcpManagerSlave() {
-        delete initializing;
-        delete configuring;
-        delete stopping;
-        delete _doStep;
+        {
+            std::lock_guard<std::mutex> lock(mtxScheduler);
+            schedulerStop = true;
+            schedulerCV.notify_all();
+        }
+        if (running != NULL) {
+            running->join();
+        }
+        //routines still pending may dispatch callbacks
+        delete lifecycleExecutor;
+        delete callbackExecutor;
         delete running;
         delete heartbeat;
     }
@@ -51,20 +61,14 @@ public:
         if (!(state == DcpState::ALIVE || state == DcpState::CONFIGURATION || state == DcpState::STOPPING ||
               state == DcpState::STOPPED || state == DcpState::ERROR_HANDLING || state == DcpState::ERROR_RESOLVED)) {
             lastExecution++;
-            std::thread *toStop = NULL;
-
-            if (state == DcpState::CONFIGURING) {
-                toStop = configuring;
-            } else if (state == DcpState::INITIALIZING) {
-                toStop = initializing;
-            }
             state = DcpState::STOPPING;
             notifyStateChange();
-            if (stopping != NULL) {
-                stopping->detach();
-                delete stopping;
+            dispatchRoutine([this] { startStopping(); });
+            {
+                // release the step scheduler, if it waits for an ASYNC step
+                std::lock_guard<std::mutex> lock(mtxScheduler);
+                schedulerCV.notify_all();
             }
-            stopping = new std::thread(&DcpManagerSlave::startStopping, this);
             return true;
         }
         return false;
@@ -431,6 +435,35 @@ public:
         asynchronousCallback[DcpCallbackTypes::STATE_CHANGED] = ftype == ASYNC;
     }
 
+    /**
+    * Set the listener for the timing of realtime steps in operation mode SRT or HRT.
+    * It is called by the step scheduler thread before each step with the number of the step since
+    * STC_run and the deviation in nanoseconds from its deadline (positive means late).
+    * @param stepDeviationListener function which will be called for each step, it must not block
+    */
+    void setStepDeviationListener(const std::function<void(uint64_t, int64_t)> stepDeviationListener) {
+        this->stepDeviationListener = std::move(stepDeviationListener);
+    }
+
+    /**
+    * Replace the worker threads. The lifecycle routines (prepare, configure, initialize, steps, stop) run in
+    * order on one worker of their own, so callbacks registered as ASYNC never delay them. The listeners
+    * registered as ASYNC run on the other workers. If a queue is full, the thread receiving the PDU waits
+    * for a free slot, instead of executing the task itself.
+    * Must be called before start().
+    * @param workers number of worker threads for ASYNC listeners, at least one
+    * @param cpus CPUs the workers are pinned to, the lifecycle worker to cpus[0]. Empty means no pinning
+    * @param capacity maximum number of pending tasks per queue
+    */
+    void setCallbackExecutor(size_t workers, const std::vector<int> &cpus = {}, size_t capacity = 256) {
+        assert(!started && "setCallbackExecutor must be called before start()");
+        delete lifecycleExecutor;
+        delete callbackExecutor;
+        lifecycleExecutor = new DcpCallbackExecutor(1, capacity,
+                                                    cpus.empty() ? std::vector<int>() : std::vector<int>{cpus[0]});
+        callbackExecutor = new DcpCallbackExecutor(workers, capacity, cpus);
+    }
+
 private:
     /* Callbacks */
     std::map<DcpCallbackTypes, bool> asynchronousCallback;
@@ -461,6 +494,8 @@ private:
     std::function<void(uint16_t dataId)> missingParameterPduListener = [](uint16_t paramId) {};
     std::function<void(int64_t unixTimeStamp)> runtimeListener = [](int64_t unixTimeStamp) {};
     std::function<void(DcpState state)> stateChangedListener = [](DcpState state) {};
+    std::function<void(uint64_t step, int64_t deviation)> stepDeviationListener = [](uint64_t step,
+                                                                                       int64_t deviation) {};
 
 
 protected:
@@ -471,15 +506,14 @@ protected:
      * obsolete.
      */
     int lastExecution;
-    std::thread *initializing = NULL;
-    std::thread *synchronizing = NULL;
-    std::thread *configuring = NULL;
-    std::thread *preparing = NULL;
-    std::thread *stopping = NULL;
-    std::thread *_doStep = NULL;
     std::thread *running = NULL;
     std::thread *heartbeat = NULL;
 
+    /* Worker thread for the lifecycle routines */
+    DcpCallbackExecutor *lifecycleExecutor = new DcpCallbackExecutor(1);
+    /* Worker threads for ASYNC listeners */
+    DcpCallbackExecutor *callbackExecutor = new DcpCallbackExecutor();
+
     /* Mutex */
     std::mutex mtxInput;
     std::mutex mtxOutput;
@@ -489,7 +523,16 @@ protected:
 
     /* Time Handling */
     std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> lastStateRequest;
-    std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> nextCommunication;
+
+    /* Realtime step scheduler */
+    std::mutex mtxScheduler;
+    std::condition_variable schedulerCV;
+    bool schedulerStop = false;
+    uint64_t schedulerGeneration = 0;
+    bool schedulerActive = false;
+    bool stepFinished = false;
+    bool runPending = false;
+    std::chrono::steady_clock::time_point runStart;
 
 
 
@@ -497,6 +540,40 @@ protected:
     *  General
     **************************/
 
+    /**
+     * Execute a listener on the callback executor
+     */
+    inline void dispatch(std::function<void()> task) {
+        submit(*callbackExecutor, std::move(task));
+    }
+
+    /**
+     * Execute a lifecycle routine on the lifecycle executor, after the routines dispatched before
+     */
+    inline void dispatchRoutine(std::function<void()> task) {
+        submit(*lifecycleExecutor, std::move(task));
+    }
+
+    /**
+     * If the queue of the executor is full, the calling thread waits until there is space again. Only a task
+     * submitted by a worker of the same executor is executed directly, as the worker would wait for itself.
+     */
+    void submit(DcpCallbackExecutor &executor, std::function<void()> &&task) {
+        if (executor.execute(std::move(task))) {
+            return;
+        }
+        if (executor.isWorkerThread()) {
+            task();
+            return;
+        }
+#ifdef DEBUG
+        Log(CALLBACK_QUEUE_FULL);
+#endif
+        do {
+            std::this_thread::yield();
+        } while (!executor.execute(std::move(task)));
+    }
+
     template<DcpState preconditon, DcpState postcondition>
     inline void routineFinished(const LogTemplate &finished, const LogTemplate &interrupted) {
 #ifdef DEBUG
@@ -518,12 +595,7 @@ protected:
 
     virtual void prepare() override {
         lastExecution++;
-        if (preparing != NULL) {
-            preparing->detach();
-            delete preparing;
-
-        }
-        preparing = new std::thread(&DcpManagerSlave::startPreparing, this);
+        dispatchRoutine([this] { startPreparing(); });
     }
 
     void startPreparing() {
@@ -531,8 +603,7 @@ protected:
         Log(PREPARING_STARTED);
 #endif
         if (asynchronousCallback[DcpCallbackTypes::PREPARE]) {
-            std::thread t(prepareCallback);
-            t.detach();
+            prepareCallback();
         } else {
             prepareCallback();
             preparingFinished();
@@ -550,12 +621,7 @@ protected:
 
     virtual void configure() override {
         lastExecution++;
-        if (configuring != NULL) {
-            configuring->detach();
-            delete configuring;
-
-        }
-        configuring = new std::thread(&DcpManagerSlave::startConfiguring, this);
+        dispatchRoutine([this] { startConfiguring(); });
     }
 
     void startConfiguring() {
@@ -563,8 +629,7 @@ protected:
         Log(CONFIGURING_STARTED);
 #endif
         if (asynchronousCallback[DcpCallbackTypes::CONFIGURE]) {
-            std::thread t(configureCallback);
-            t.detach();
+            configureCallback();
         } else {
             configureCallback();
             configuringFinished();
@@ -582,11 +647,7 @@ protected:
 
     virtual void initialize() override {
         lastExecution++;
-        if (initializing != NULL) {
-            initializing->detach();
-            delete initializing;
-        }
-        initializing = new std::thread(&DcpManagerSlave::startInitializing, this);
+        dispatchRoutine([this] { startInitializing(); });
     }
 
     void startInitializing() {
@@ -595,8 +656,7 @@ protected:
 #endif
 
         if (asynchronousCallback[DcpCallbackTypes::INITIALIZE]) {
-            std::thread t(initializeCallback);
-            t.detach();
+            initializeCallback();
         } else {
             initializeCallback();
             initializingFinished();
@@ -613,11 +673,7 @@ protected:
 
     virtual void synchronize() override {
         lastExecution++;
-        if (synchronizing != NULL) {
-            synchronizing->detach();
-            delete synchronizing;
-        }
-        synchronizing = new std::thread(&DcpManagerSlave::startSynchronizing, this);
+        dispatchRoutine([this] { startSynchronizing(); });
     }
 
     void startSynchronizing() {
@@ -626,8 +682,7 @@ protected:
 #endif
 
         if (asynchronousCallback[DcpCallbackTypes::SYNCHRONIZE]) {
-            std::thread t(synchronizeCallback);
-            t.detach();
+            synchronizeCallback();
         } else {
             synchronizeCallback();
             synchronizingFinished();
@@ -655,12 +710,7 @@ protected:
     **************************/
 
     virtual void doStep(const uint32_t steps) override {
-        if (_doStep != NULL) {
-            _doStep->detach();
-            delete _doStep;
-        }
-        _doStep = new std::thread(&DcpManagerSlave::startComputing, this,
-                                  steps);
+        dispatchRoutine([this, steps] { startComputing(steps); });
     }
 
     void startComputing(uint32_t steps) {
@@ -672,8 +722,7 @@ protected:
             case DcpState::RUNNING: {
                 if (state == DcpState::RUNNING) {
                     if (asynchronousCallback[DcpCallbackTypes::RUNNING_NRT_STEP]) {
-                        std::thread t(runningNRTStepCallback, steps);
-                        t.detach();
+                        runningNRTStepCallback(steps);
                     } else {
                         runningNRTStepCallback(steps);
                         computingFinished();
@@ -683,8 +732,7 @@ protected:
             }
             case DcpState::SYNCHRONIZING: {
                 if (asynchronousCallback[DcpCallbackTypes::SYNCHRONIZING_NRT_STEP]) {
-                    std::thread t(synchronizingNRTStepCallback, steps);
-                    t.detach();
+                    synchronizingNRTStepCallback(steps);
                 } else {
                     synchronizingNRTStepCallback(steps);
                     computingFinished();
@@ -693,8 +741,7 @@ protected:
             }
             case DcpState::SYNCHRONIZED: {
                 if (asynchronousCallback[DcpCallbackTypes::SYNCHRONIZED_NRT_STEP]) {
-                    std::thread t(synchronizedNRTStepCallback, steps);
-                    t.detach();
+                    synchronizedNRTStepCallback(steps);
                 } else {
                     synchronizedNRTStepCallback(steps);
                     computingFinished();
@@ -717,95 +764,134 @@ protected:
     **************************/
 
     virtual void run(const int64_t startTime) override {
+        std::unique_lock<std::mutex> lock(mtxScheduler);
+        if (state == DcpState::RUNNING && schedulerActive) {
+            // the scheduler is already stepping, switch to RUNNING at the start time
+            runStart = toSteadyClock(startTime);
+            runPending = true;
+            return;
+        }
+        const uint64_t generation = ++schedulerGeneration;
+        schedulerActive = true;
+        runPending = false;
+        schedulerCV.notify_all();
+        lock.unlock();
         if (running != NULL) {
-            running->detach();
+            running->join();
             delete running;
         }
-        running = new std::thread(&DcpManagerSlave::startRealtime,
-                                  this, startTime);
+        running = new std::thread(&DcpManagerSlave::realtimeScheduler, this, startTime, generation);
     }
 
-    void startRealtime(int64_t startTime) {
+    /**
+     * Step scheduler for SRT and HRT. Runs one step per tick on its own thread until the realtime
+     * states are left or a newer scheduler is started. The deadline of each tick is computed absolute
+     * from the start time, so late steps do not accumulate drift.
+     */
+    void realtimeScheduler(int64_t startTime, uint64_t generation) {
         using namespace std::chrono;
-        if (startTime == 0) {
-            nextCommunication = time_point_cast<microseconds>(system_clock::now());
-        } else {
-            nextCommunication = time_point<system_clock, microseconds>(
-                    seconds(startTime));
-            std::this_thread::sleep_until(nextCommunication);
+        const steady_clock::time_point epoch = toSteadyClock(startTime);
+        if (!waitForDeadline(epoch, generation)) {
+            return;
         }
+        realtimeState = state;
+
+        for (uint64_t tick = 0; isRealtimeState(); tick++) {
+            const steady_clock::time_point deadline = epoch + tickOffset(tick);
+            if (!waitForDeadline(deadline, generation)) {
+                return;
+            }
+            const steady_clock::time_point now = steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(mtxScheduler);
+                if (runPending && now >= runStart) {
+                    realtimeState = DcpState::RUNNING;
+                    runPending = false;
+                }
+            }
+            if (!isRealtimeState()) {
+                break;
+            }
 
-        if(state == DcpState::SYNCHRONIZING){
-            realtimeState = state;
-            startRealtimeStep();
-            synchronize();
-        } else if(state == DcpState::RUNNING){
-            realtimeState = state;
+            int64_t deviation = duration_cast<nanoseconds>(now - deadline).count();
+            stepDeviationListener(tick, deviation);
+#ifdef DEBUG
+            if (deviation > 0 && deviation >= tickOffset(1).count()) {
+                Log(REALTIME_STEP_LATE, tick, deviation);
+            }
+#endif
+            realtimeStep(generation);
+            if (tick == 0 && realtimeState == DcpState::SYNCHRONIZING) {
+                synchronize();
+            }
+        }
+        std::lock_guard<std::mutex> lock(mtxScheduler);
+        if (generation == schedulerGeneration) {
+            schedulerActive = false;
+            runPending = false;
         }
     }
 
-    void startRealtimeStep() {
-        using namespace std::chrono;
+    /**
+     * Sleep until the deadline.
+     * @return False if the scheduler of the given generation has to terminate
+     */
+    bool waitForDeadline(std::chrono::steady_clock::time_point deadline, uint64_t generation) {
+        std::unique_lock<std::mutex> lock(mtxScheduler);
+        schedulerCV.wait_until(lock, deadline, [this, generation] {
+            return schedulerStop || generation != schedulerGeneration;
+        });
+        return !schedulerStop && generation == schedulerGeneration;
+    }
 
-        uint32_t steps = 1;
+    void realtimeStep(uint64_t generation) {
+        const uint32_t steps = 1;
+        std::function<void(uint64_t steps)> *stepCallback;
+        bool async;
 
         switch (realtimeState) {
             case DcpState::RUNNING: {
-                if (state == DcpState::RUNNING) {
-                    mtxInput.lock();
-                    mtxOutput.lock();
-
-                    if (asynchronousCallback[DcpCallbackTypes::RUNNING_STEP]) {
-                        std::thread t(runningStepCallback, steps);
-                        t.detach();
-                    } else {
-                        runningStepCallback(steps);
-                        std::thread t(&DcpManagerSlave::realtimeStepFinished, this);
-                        t.detach();
-                    }
+                if (state != DcpState::RUNNING) {
+                    return;
                 }
+                stepCallback = &runningStepCallback;
+                async = asynchronousCallback[DcpCallbackTypes::RUNNING_STEP];
                 break;
             }
             case DcpState::SYNCHRONIZING: {
-                mtxInput.lock();
-                mtxOutput.lock();
-
-                if (asynchronousCallback[DcpCallbackTypes::SYNCHRONIZING_STEP]) {
-                    std::thread t(synchronizingStepCallback, steps);
-                    t.detach();
-                } else {
-                    synchronizingStepCallback(steps);
-                    std::thread t(&DcpManagerSlave::realtimeStepFinished, this);
-                    t.detach();
-                }
+                stepCallback = &synchronizingStepCallback;
+                async = asynchronousCallback[DcpCallbackTypes::SYNCHRONIZING_STEP];
                 break;
             }
             case DcpState::SYNCHRONIZED: {
-                mtxInput.lock();
-                mtxOutput.lock();
-
-                if (asynchronousCallback[DcpCallbackTypes::SYNCHRONIZED_STEP]) {
-                    std::thread t(synchronizedStepCallback, steps);
-                    t.detach();
-                } else {
-                    synchronizedStepCallback(steps);
-                    std::thread t(&DcpManagerSlave::realtimeStepFinished, this);
-                    t.detach();
-                }
+                stepCallback = &synchronizedStepCallback;
+                async = asynchronousCallback[DcpCallbackTypes::SYNCHRONIZED_STEP];
                 break;
             }
             default: {
                 //realtime routine is only in RUNNING, SYNCHRONIZING, SYNCHRONIZED active.
-                break;
+                return;
             }
         }
-    }
 
-    virtual void realtimeStepFinished() {
+        mtxInput.lock();
+        mtxOutput.lock();
+        if (async) {
+            // an ASYNC callback does not block, its end is signaled by simulationStepFinished
+            std::unique_lock<std::mutex> lock(mtxScheduler);
+            stepFinished = false;
+            lock.unlock();
+            (*stepCallback)(steps);
+            lock.lock();
+            schedulerCV.wait(lock, [this, generation] {
+                return stepFinished || schedulerStop || generation != schedulerGeneration || !isRealtimeState();
+            });
+        } else {
+            (*stepCallback)(steps);
+        }
         mtxInput.unlock();
-        uint32_t steps = 1;
 
-        for (std::tuple<std::vector<uint16_t>, uint32_t, uint32_t> el : outputCounter) {
+        for (std::tuple<std::vector<uint16_t>, uint32_t, uint32_t> &el : outputCounter) {
             std::get<1>(el) -= steps;
             if (std::get<1>(el) == 0) {
                 std::get<1>(el) = 0 + std::get<2>(el);
@@ -813,35 +899,116 @@ protected:
             }
         }
         mtxOutput.unlock();
+    }
 
-        nextCommunication += std::chrono::microseconds((int64_t) ((((double) numerator) / ((double) denominator)
-                                                                   * ((double) steps)) * 1000000.0));
-        //steps = newSteps;
-        std::this_thread::sleep_until(nextCommunication);
-        startRealtimeStep();
+    virtual void realtimeStepFinished() {
+        std::lock_guard<std::mutex> lock(mtxScheduler);
+        stepFinished = true;
+        schedulerCV.notify_all();
     }
 
+    inline bool isRealtimeState() {
+        return state == DcpState::SYNCHRONIZING || state == DcpState::SYNCHRONIZED || state == DcpState::RUNNING;
+    }
 
-    virtual void sendOutputs(std::vector<dataId_t> dataIdsToSend) override {
-        for (dataId_t dataId  : dataIdsToSend) {
-            if (outputAssignment.find(dataId) == outputAssignment.end()) {
-                continue;
-            }
-            DcpPduDatInputOutput *pdu = outputBuffer[dataId];
-            size_t offset = 0;
+    /**
+     * Offset of a tick from the start of the scheduler, exact up to one nanosecond.
+     * A tick lasts numerator / denominator seconds.
+     */
+    inline std::chrono::nanoseconds tickOffset(uint64_t tick) {
+        const uint64_t ticks = tick * numerator;
+        const uint64_t seconds = ticks / denominator;
+        const uint64_t remainder = ticks % denominator;
+        return std::chrono::nanoseconds(seconds * 1000000000 + (remainder * 1000000000) / denominator);
+    }
 
-            std::map<uint16_t, uint64_t> vrsToSend = outputAssignment[dataId];
-            for (uint16_t i = 0; i < vrsToSend.size(); i++) {
-                uint64_t vr = vrsToSend[i];
+    static std::chrono::steady_clock::time_point toSteadyClock(int64_t unixTimeStamp) {
+        using namespace std::chrono;
+        const steady_clock::time_point now = steady_clock::now();
+        if (unixTimeStamp == 0) {
+            return now;
+        }
+        return now + duration_cast<steady_clock::duration>(
+                system_clock::time_point(seconds(unixTimeStamp)) - system_clock::now());
+    }
 
-                offset += values[vr]->serialize(pdu->getPayload(), offset);
 
+    virtual void sendOutputs(const std::vector<dataId_t> &dataIdsToSend) override {
+        //a structural parameter may rebuild the serialization plan meanwhile
+        StructureLock::Shared lock(structureLock);
+        outputBatch.clear();
+        for (dataId_t dataId  : dataIdsToSend) {
+            if (dataId >= outputSerializationPlan.size() || outputSerializationPlan[dataId].pdu == nullptr) {
+                continue;
+            }
+            const OutputSerializationPlan &plan = outputSerializationPlan[dataId];
+            uint8_t *stream = driver.acquireOutput ? driver.acquireOutput(dataId, plan.capacity) : nullptr;
+            if (stream != nullptr) {
+                //serialize directly into the memory of the transport protocol
+                DcpPduDatInputOutput pdu(stream, plan.capacity - PDU_LENGTH_INDICATOR_SIZE);
+                pdu.getTypeId() = DcpPduType::DAT_input_output;
+                pdu.getDataId() = dataId;
+                size_t size;
+                if (!serializeOutput(plan, pdu.getPayload(), size)) {
+                    //the slot was not published, the next PDU reuses it
+                    continue;
+                }
+                pdu.getPduSeqId() = getNextDataSeqNum(dataId);
+                pdu.setPduSize(size + 5);
+                driver.send(pdu);
+                continue;
+            }
+            DcpPduDatInputOutput *pdu = plan.pdu;
+            size_t size;
+            if (!serializeOutput(plan, pdu->getPayload(), size)) {
+                continue;
             }
-            pdu->getPduSeqId() = getNextDataSeqNum(pdu->getDataId());
-            pdu->setPduSize(offset + 5);
+            pdu->getPduSeqId() = getNextDataSeqNum(dataId);
+            pdu->setPduSize(size + 5);
+            outputBatch.push_back(pdu);
+        }
+        if (outputBatch.empty()) {
+            return;
+        }
+        if (driver.sendBatch) {
+            driver.sendBatch(outputBatch.data(), outputBatch.size());
+        } else {
+            for (DcpPdu *pdu : outputBatch) {
+                driver.send(*pdu);
+            }
+        }
+    }
 
-            driver.send(*pdu);
+    /**
+     * Serialize the outputs of one data id. Nothing is sent if the variable size outputs outgrow the
+     * capacity of the plan.
+     * @param plan serialization plan of the data id
+     * @param payload payload of the DAT_input_output PDU
+     * @param size number of bytes written
+     * @return false if the outputs do not fit into the payload
+     */
+    inline bool serializeOutput(const OutputSerializationPlan &plan, uint8_t *payload, size_t &size) {
+        const size_t capacity = plan.capacity - PDU_LENGTH_INDICATOR_SIZE - 5;
+        size_t offset = 0;
+        for (size_t i = plan.first; i < plan.last; i++) {
+            const OutputSerializationStep &step = outputSerializationSteps[i];
+            const size_t length = step.count == 0 ? step.length
+                                                  : serializedVariableSize(step.source, step.count, step.baseSize);
+            if (length > capacity - offset) {
+#if defined(DEBUG) || defined(LOGGING)
+                Log(OUTPUT_EXCEEDS_BUFFER, plan.pdu->getDataId(), (uint64_t) capacity);
+#endif
+                return false;
+            }
+            if (step.count == 0) {
+                std::memcpy(payload + offset, step.source, step.length);
+            } else {
+                serializeVariable(payload + offset, step.source, step.count, step.baseSize);
+            }
+            offset += length;
         }
+        size = offset;
+        return true;
     }
 
     virtual void updateLastStateRequest() override {
@@ -861,8 +1028,7 @@ protected:
         Log(STOPPING_STARTED);
 #endif
         if (asynchronousCallback[DcpCallbackTypes::STOP]) {
-            std::thread t(stopCallback);
-            t.detach();
+            stopCallback();
         } else {
             stopCallback();
             stoppingFinished();
@@ -937,8 +1103,7 @@ protected:
 
     virtual void notifyStateChangedListener() override {
         if (asynchronousCallback[DcpCallbackTypes::STATE_CHANGED]) {
-            std::thread t(stateChangedListener, state);
-            t.detach();
+            dispatch(std::bind(stateChangedListener, state));
         } else {
             stateChangedListener(state);
         }
@@ -946,8 +1111,7 @@ protected:
 
     virtual void notifyTimeResListener() override {
         if (asynchronousCallback[DcpCallbackTypes::TIME_RES]) {
-            std::thread t(timeResListener, numerator, denominator);
-            t.detach();
+            dispatch(std::bind(timeResListener, numerator, denominator));
         } else {
             timeResListener(numerator, denominator);
         }
@@ -955,8 +1119,7 @@ protected:
 
     virtual void notifyStepsListener(uint16_t dataId, uint32_t steps) override {
         if (asynchronousCallback[DcpCallbackTypes::STEPS]) {
-            std::thread t(stepsListener, dataId, steps);
-            t.detach();
+            dispatch(std::bind(stepsListener, dataId, steps));
         } else {
             stepsListener(dataId, steps);
         }
@@ -964,8 +1127,7 @@ protected:
 
     virtual void notifyOperationInformationListener() override {
         if (asynchronousCallback[DcpCallbackTypes::OPERATION_INFORMATION]) {
-            std::thread t(operationInformationListener, dcpId, opMode);
-            t.detach();
+            dispatch(std::bind(operationInformationListener, dcpId, opMode));
         } else {
             operationInformationListener(dcpId, opMode);
         }
@@ -973,8 +1135,7 @@ protected:
 
     virtual void notifyRuntimeListener(int64_t unixTimeStamp) override {
         if (asynchronousCallback[DcpCallbackTypes::RUNTIME]) {
-            std::thread t(runtimeListener, unixTimeStamp);
-            t.detach();
+            dispatch(std::bind(runtimeListener, unixTimeStamp));
         } else {
             runtimeListener(unixTimeStamp);
         }
@@ -982,8 +1143,7 @@ protected:
 
     virtual void notifyMissingControlPduListener() override {
         if (asynchronousCallback[DcpCallbackTypes::CONTROL_MISSED]) {
-            std::thread t(missingControlPduListener);
-            t.detach();
+            dispatch(missingControlPduListener);
         } else {
             missingControlPduListener();
         }
@@ -991,8 +1151,7 @@ protected:
 
     virtual void notifyMissingInputOutputPduListener(uint16_t dataId) override {
         if (asynchronousCallback[DcpCallbackTypes::IN_OUT_MISSED]) {
-            std::thread t(missingInputOutputPduListener, dataId);
-            t.detach();
+            dispatch(std::bind(missingInputOutputPduListener, dataId));
         } else {
             missingInputOutputPduListener(dataId);
         }
@@ -1000,8 +1159,7 @@ protected:
 
     virtual void notifyMissingParameterPduListener(uint16_t paramId) override {
         if (asynchronousCallback[DcpCallbackTypes::CONTROL_MISSED]) {
-            std::thread t(missingParameterPduListener, paramId);
-            t.detach();
+            dispatch(std::bind(missingParameterPduListener, paramId));
         } else {
             missingParameterPduListener(paramId);
         }
@@ -1009,8 +1167,7 @@ protected:
 
     virtual void reportError(const DcpError errorCode) override {
         if (asynchronousCallback[DcpCallbackTypes::ERROR_LI]) {
-            std::thread t(errorListener, errorCode);
-            t.detach();
+            dispatch(std::bind(errorListener, errorCode));
         } else {
             errorListener(errorCode);
         }
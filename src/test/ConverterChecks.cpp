@@ -0,0 +1,75 @@
+//
+// Compares the vectorized conversion kernels against the scalar reference for every allowed pair
+//
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <dcp/helper/Helper.hpp>
+#include <dcp/model/DcpConverter.hpp>
+
+static const DcpDataType fixedTypes[] = {DcpDataType::uint8, DcpDataType::uint16, DcpDataType::uint32,
+                                         DcpDataType::uint64, DcpDataType::int8, DcpDataType::int16,
+                                         DcpDataType::int32, DcpDataType::int64, DcpDataType::float32,
+                                         DcpDataType::float64};
+
+int main() {
+    // odd count and offsets to cover the scalar tails and unaligned access
+    const size_t count = 1037;
+    const size_t misalignment = 3;
+    std::vector<uint8_t> source(count * 8 + misalignment);
+    srand(42);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = (uint8_t) rand();
+    }
+
+    int failures = 0;
+    int checked = 0;
+    for (DcpDataType dataType : fixedTypes) {
+        for (DcpDataType sourceDataType : fixedTypes) {
+            DcpConverter reference = getConverter(dataType, sourceDataType, ConverterIsa::SCALAR);
+            if (reference == &convertNothing) {
+                continue;
+            }
+            size_t baseSize = getDcpDataTypeSize(dataType);
+            const uint8_t *input = source.data() + misalignment;
+            if (sourceDataType == DcpDataType::float32) {
+                // avoid NaN payloads, which do not compare bitwise
+                for (size_t i = 0; i < count; i++) {
+                    float32_t value = (float32_t) (rand() - RAND_MAX / 2) / 7.0f;
+                    std::memcpy(source.data() + misalignment + i * 4, &value, 4);
+                }
+            }
+            std::vector<uint8_t> expected(count * baseSize + misalignment);
+            size_t expectedConsumed = reference(expected.data() + misalignment, input, count, baseSize);
+
+            const ConverterIsa isas[] = {ConverterIsa::SSE2, ConverterIsa::AVX2};
+            for (ConverterIsa isa : isas) {
+                if (isa > getSupportedConverterIsa()) {
+                    continue;
+                }
+                for (size_t n = 0; n <= 17; n++) {
+                    // short arrays hit the tail handling only
+                    size_t length = n == 17 ? count : n;
+                    std::vector<uint8_t> actual(count * baseSize + misalignment, 0);
+                    std::vector<uint8_t> scalar(count * baseSize + misalignment, 0);
+                    size_t consumed = getConverter(dataType, sourceDataType, isa)(actual.data() + misalignment,
+                                                                                 input, length, baseSize);
+                    reference(scalar.data() + misalignment, input, length, baseSize);
+                    checked++;
+                    if (consumed != length * getDcpDataTypeSize(sourceDataType) ||
+                        std::memcmp(actual.data(), scalar.data(), actual.size()) != 0 ||
+                        (length == count && std::memcmp(actual.data(), expected.data(), actual.size()) != 0) ||
+                        (length == count && consumed != expectedConsumed)) {
+                        failures++;
+                        std::printf("Mismatch: %d <- %d (isa %d, count %zu)\n", (int) dataType,
+                                    (int) sourceDataType, (int) isa, length);
+                    }
+                }
+            }
+        }
+    }
+    std::printf("%d conversions checked, %d failures\n", checked, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,502 @@
+//
+// Microbenchmarks of the codec and dispatch hot paths
+//
+// Every measurement is printed as one JSON object per line:
+// {"benchmark":"...","case":"...","bytes":...,"iterations":...,"ns_per_op":...}
+// bytes is the payload handled by one operation, 0 if it does not apply.
+//
+// usage: hotPathBenchmark [minimum time per case in ms] [benchmark name filter]
+//
+// the DEBUG log messages of the receive and send path would dominate the measurement
+#undef DEBUG
+#define LOGGING
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dcp/logic/DcpManagerSlave.hpp>
+#include <dcp/logic/DcpManagerMaster.hpp>
+#include <dcp/logic/DCPSlaveErrorCodes.hpp>
+#include <dcp/logic/Logable.hpp>
+#include <dcp/logic/LogRing.hpp>
+#include <dcp/model/MultiDimValue.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+using namespace std::chrono;
+
+static double minTime = 0.1;
+static const char *filter = nullptr;
+
+// keeps results of the measured operations alive
+static volatile size_t sink = 0;
+
+static bool selected(const char *benchmark) {
+    return filter == nullptr || std::strstr(benchmark, filter) != nullptr;
+}
+
+template<typename Operation>
+static void measure(const char *benchmark, const std::string &caseName, size_t bytes, Operation operation) {
+    if (!selected(benchmark)) {
+        return;
+    }
+    //warm up caches and lazily initialized state
+    for (int i = 0; i < 16; i++) {
+        operation();
+    }
+    size_t iterations = 16;
+    double elapsed = 0;
+    for (;;) {
+        const auto start = steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            operation();
+        }
+        elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        if (elapsed >= minTime) {
+            break;
+        }
+        iterations *= elapsed > minTime / 16 ? 2 : 16;
+    }
+    std::printf("{\"benchmark\":\"%s\",\"case\":\"%s\",\"bytes\":%zu,\"iterations\":%zu,\"ns_per_op\":%.2f}\n",
+                benchmark, caseName.c_str(), bytes, iterations, elapsed * 1e9 / iterations);
+    std::fflush(stdout);
+}
+
+static const DcpDataType fixedTypes[] = {DcpDataType::uint8, DcpDataType::uint16, DcpDataType::uint32,
+                                         DcpDataType::uint64, DcpDataType::int8, DcpDataType::int16,
+                                         DcpDataType::int32, DcpDataType::int64, DcpDataType::float32,
+                                         DcpDataType::float64};
+
+// number of elements of the MultiDimValue cases
+static const size_t elementCounts[] = {1, 1024, 65536};
+
+// payload mixes of the DAT PDUs, used as data id and param id. Arrays are float64, strings fit into STRING_MAX_SIZE
+static const uint16_t SCALAR_ID = 1;
+static const uint16_t ARRAY_1K_ID = 2;
+static const uint16_t ARRAY_64K_ID = 3;
+static const uint16_t STRING_ID = 4;
+static const uint16_t OVERSIZED_ID = 5;
+static const size_t ARRAY_1K_ELEMENTS = 128;
+// the largest float64 array a DAT PDU carries, its payload size is 16 bit
+static const size_t ARRAY_64K_ELEMENTS = 65535 / 8;
+// 64 KiB, one element more than fits into a DAT PDU
+static const size_t OVERSIZED_ELEMENTS = 65536 / 8;
+static const uint32_t STRING_MAX_SIZE = 260;
+static const size_t STRING_LENGTH = 200;
+
+static std::string countName(size_t count) {
+    return count >= 1024 ? std::to_string(count / 1024) + "k" : std::to_string(count);
+}
+
+/**
+ * Fill buffer with count values of dataType. Floating point values are kept finite.
+ */
+static void fill(std::vector<uint8_t> &buffer, DcpDataType dataType, size_t count) {
+    const size_t baseSize = getDcpDataTypeSize(dataType);
+    buffer.resize(count * baseSize);
+    for (size_t i = 0; i < count; i++) {
+        if (dataType == DcpDataType::float32) {
+            float32_t value = (float32_t) i * 0.25f;
+            std::memcpy(buffer.data() + i * baseSize, &value, baseSize);
+        } else if (dataType == DcpDataType::float64) {
+            float64_t value = (float64_t) i * 0.25;
+            std::memcpy(buffer.data() + i * baseSize, &value, baseSize);
+        } else {
+            for (size_t j = 0; j < baseSize; j++) {
+                buffer[i * baseSize + j] = (uint8_t) (i * 31 + j);
+            }
+        }
+    }
+}
+
+static void benchmarkMultiDimValue() {
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> output;
+    for (size_t count : elementCounts) {
+        for (DcpDataType dataType : fixedTypes) {
+            const size_t baseSize = getDcpDataTypeSize(dataType);
+            MultiDimValue value(dataType, baseSize, {count});
+            for (DcpDataType sourceDataType : fixedTypes) {
+                if (getConverter(dataType, sourceDataType) == &convertNothing) {
+                    continue;
+                }
+                fill(source, sourceDataType, count);
+                measure("MultiDimValue::update", to_string(sourceDataType) + "->" + to_string(dataType) + "/n=" +
+                                                 countName(count), source.size(), [&] {
+                    sink += value.update(source.data(), 0, sourceDataType);
+                });
+            }
+            output.resize(value.getSize());
+            measure("MultiDimValue::serialize", to_string(dataType) + "/n=" + countName(count), output.size(), [&] {
+                sink += value.serialize(output.data(), 0);
+            });
+        }
+
+        //variable sized types are stored with their maximum size and serialized with their actual length
+        const DcpDataType variableTypes[] = {DcpDataType::string, DcpDataType::binary};
+        for (DcpDataType dataType : variableTypes) {
+            MultiDimValue value(dataType, STRING_MAX_SIZE, {count});
+            source.assign(count * (4 + STRING_LENGTH), 'x');
+            for (size_t i = 0; i < count; i++) {
+                *((uint32_t *) (source.data() + i * (4 + STRING_LENGTH))) = STRING_LENGTH;
+            }
+            measure("MultiDimValue::update", to_string(dataType) + "->" + to_string(dataType) + "/n=" +
+                                             countName(count), source.size(), [&] {
+                sink += value.update(source.data(), 0, dataType);
+            });
+            output.resize(source.size());
+            measure("MultiDimValue::serialize", to_string(dataType) + "/n=" + countName(count), output.size(), [&] {
+                sink += value.serialize(output.data(), 0);
+            });
+        }
+    }
+}
+
+static void benchmarkMakeDcpPdu() {
+    std::vector<uint8_t> payload(ARRAY_64K_ELEMENTS * 8, 0);
+    struct PduCase {
+        const char *name;
+        DcpPdu *pdu;
+    };
+    PduCase cases[] = {
+            {"DAT_input_output/scalar", new DcpPduDatInputOutput(1, SCALAR_ID, payload.data(), 10)},
+            {"DAT_input_output/array1k", new DcpPduDatInputOutput(1, ARRAY_1K_ID, payload.data(),
+                                                                  ARRAY_1K_ELEMENTS * 8)},
+            {"DAT_input_output/array64k", new DcpPduDatInputOutput(1, ARRAY_64K_ID, payload.data(),
+                                                                   ARRAY_64K_ELEMENTS * 8)},
+            {"DAT_parameter/scalar", new DcpPduDatParameter(1, SCALAR_ID, payload.data(), 8)},
+            {"STC_do_step", new DcpPduStcDoStep(1, 1, DcpState::RUNNING, 1)},
+            {"CFG_input", new DcpPduCfgInput(1, 1, SCALAR_ID, 0, 1, DcpDataType::float64)},
+            {"CFG_target_network_information", new DcpPduCfgNetworkInformationIPv4(
+                    DcpPduType::CFG_target_network_information, 1, 1, SCALAR_ID, 5000, 0x7f000001,
+                    DcpTransportProtocol::UDP_IPv4)},
+    };
+    for (PduCase &pduCase : cases) {
+        unsigned char *stream = pduCase.pdu->serialize();
+        const size_t size = pduCase.pdu->getPduSize();
+        measure("makeDcpPdu", std::string(pduCase.name) + "/heap", size, [&] {
+            DcpPdu *pdu = makeDcpPdu(stream, size);
+            sink += (size_t) pdu->getTypeId();
+            delete pdu;
+        });
+        measure("makeDcpPdu", std::string(pduCase.name) + "/view", size, [&] {
+            DcpPduView view(stream, size);
+            sink += (size_t) view->getTypeId();
+        });
+        delete pduCase.pdu;
+    }
+}
+
+static void benchmarkLog() {
+    struct NullLogable : public Logable {
+    };
+    NullLogable logable;
+    LogFilter logFilter;
+    LogManager logManager{[](const LogTemplate &, uint8_t *payload, size_t size) { sink += size; },
+                          [](size_t size) { return new uint8_t[size]; }, nullptr, &logFilter};
+    logable.setLogManager(logManager);
+    const std::string checkedTime = "2019-01-01 00:00:00.000000";
+
+    auto logAll = [&](const std::string &mode) {
+        measure("Logable::Log", "STATE_CHANGED/" + mode, 0, [&] {
+            logable.Log(STATE_CHANGED, DcpState::RUNNING);
+        });
+        measure("Logable::Log", "ASSIGNED_INPUT/" + mode, 0, [&] {
+            logable.Log(ASSIGNED_INPUT, (uint64_t) 1, DcpDataType::int16, DcpDataType::int32);
+        });
+        measure("Logable::Log", "HEARTBEAT_MISSED/" + mode, 0, [&] {
+            logable.Log(HEARTBEAT_MISSED, checkedTime, checkedTime);
+        });
+    };
+
+    logAll("filtered");
+    logFilter.enableAll();
+    logAll("consume");
+
+    LogRing ring;
+    ring.start([](const LogTemplate &, uint8_t *payload, size_t size) { sink += size; });
+    logManager.ring = &ring;
+    logable.setLogManager(logManager);
+    //a full ring falls back to consume, as it does in the library
+    logAll("ring");
+    ring.stop();
+}
+
+static DcpDriver makeDriver(std::function<void(DcpPdu &)> send) {
+    DcpDriver driver;
+    driver.send = send;
+    driver.setSlaveNetworkInformation = [](dcpId_t, uint8_t *) {};
+    driver.setSourceNetworkInformation = [](dataId_t, uint8_t *) {};
+    driver.setTargetNetworkInformation = [](dataId_t, uint8_t *) {};
+    driver.setParamNetworkInformation = [](paramId_t, uint8_t *) {};
+    driver.setTargetParamNetworkInformation = [](paramId_t, uint8_t *) {};
+    driver.startReceiving = [] {};
+    driver.connectToSlave = [](dcpId_t) {};
+    driver.disconnectFromSlave = [](dcpId_t) {};
+    driver.setDcpManager = [](DcpManager) {};
+    driver.setLogManager = [](LogManager) {};
+    driver.registerSuccessfull = [] {};
+    driver.prepare = [] {};
+    driver.configure = [] {};
+    driver.stop = [] {};
+    driver.disconnect = [] {};
+    return driver;
+}
+
+static std::vector<Dimension_t> arrayDimensions(size_t elements) {
+    return {make_Dimension(DimensionType::CONSTANT, elements)};
+}
+
+static SlaveDescription_t makeSlaveDescription() {
+    SlaveDescription_t slaveDescription = make_SlaveDescription(1, 0, "dcpslave",
+                                                                "b5279485-720d-4542-9f29-bee4d9a75ef9");
+    slaveDescription.OpMode.NonRealTime = make_NonRealTime_ptr();
+    Resolution_t resolution = make_Resolution();
+    resolution.numerator = 1;
+    resolution.denominator = 1000;
+    slaveDescription.TimeRes.resolutions.push_back(resolution);
+    slaveDescription.TransportProtocols.UDP_IPv4 = make_UDP_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->Control = make_Control_ptr("127.0.0.1", 8080);
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_input_output = make_DAT_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_input_output->availablePortRanges.push_back(
+            make_AviablePortRange(2048, 65535));
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_parameter = make_DAT_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_parameter->availablePortRanges.push_back(
+            make_AviablePortRange(2048, 65535));
+    slaveDescription.CapabilityFlags.canAcceptConfigPdus = true;
+    slaveDescription.CapabilityFlags.canHandleVariableSteps = true;
+
+    //inputs: 1, 2 scalars, 3 1 KiB array, 4 64 KiB - 8 byte array, 5 string
+    slaveDescription.Variables.push_back(make_Variable_input("a", 1, make_CommonCausality_ptr<float64_t>()));
+    slaveDescription.Variables.push_back(make_Variable_input("b", 2, make_CommonCausality_ptr<int32_t>()));
+    std::shared_ptr<CommonCausality_t> c = make_CommonCausality_ptr<float64_t>();
+    c->dimensions = arrayDimensions(ARRAY_1K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_input("c", 3, c));
+    std::shared_ptr<CommonCausality_t> d = make_CommonCausality_ptr<float64_t>();
+    d->dimensions = arrayDimensions(ARRAY_64K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_input("d", 4, d));
+    std::shared_ptr<CommonCausality_t> e = make_CommonCausality_String_ptr();
+    e->String->maxSize = std::make_shared<uint32_t>(STRING_MAX_SIZE);
+    slaveDescription.Variables.push_back(make_Variable_input("e", 5, e));
+
+    //outputs: 11, 12 scalars, 13 1 KiB array, 14 64 KiB - 8 byte array, 15 64 KiB array
+    slaveDescription.Variables.push_back(make_Variable_output("f", 11, make_Output_ptr<float64_t>()));
+    slaveDescription.Variables.push_back(make_Variable_output("g", 12, make_Output_ptr<int32_t>()));
+    std::shared_ptr<Output_t> h = make_Output_ptr<float64_t>();
+    h->dimensions = arrayDimensions(ARRAY_1K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_output("h", 13, h));
+    std::shared_ptr<Output_t> i = make_Output_ptr<float64_t>();
+    i->dimensions = arrayDimensions(ARRAY_64K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_output("i", 14, i));
+    std::shared_ptr<Output_t> m = make_Output_ptr<float64_t>();
+    m->dimensions = arrayDimensions(OVERSIZED_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_output("m", 15, m));
+
+    //tunable parameters: 21 scalar, 22 1 KiB array, 23 64 KiB - 8 byte array
+    slaveDescription.Variables.push_back(make_Variable_parameter("j", 21, make_CommonCausality_ptr<float64_t>()));
+    std::shared_ptr<CommonCausality_t> k = make_CommonCausality_ptr<float64_t>();
+    k->dimensions = arrayDimensions(ARRAY_1K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_parameter("k", 22, k));
+    std::shared_ptr<CommonCausality_t> l = make_CommonCausality_ptr<float64_t>();
+    l->dimensions = arrayDimensions(ARRAY_64K_ELEMENTS);
+    slaveDescription.Variables.push_back(make_Variable_parameter("l", 23, l));
+    return slaveDescription;
+}
+
+struct DatCase {
+    const char *name;
+    DcpPdu *pdu;
+    uint16_t *seqId;
+};
+
+template<typename T>
+static DatCase makeDatCase(const char *name, T *pdu) {
+    return {name, pdu, &pdu->getPduSeqId()};
+}
+
+/**
+ * Exposes sendOutputs, which is otherwise only called by the slave itself.
+ */
+class BenchmarkSlave : public DcpManagerSlave {
+public:
+    BenchmarkSlave(const SlaveDescription_t &slaveDescription, const DcpDriver &driver) : DcpManagerSlave(
+            slaveDescription, driver) {}
+
+    using DcpManagerSlave::sendOutputs;
+};
+
+static bool benchmarkSlave() {
+    BenchmarkSlave *slavePtr = nullptr;
+    DcpManagerMaster *masterPtr = nullptr;
+    // PDUs are passed between master and slave as raw bytes, like a driver does
+    DcpManagerMaster master(makeDriver([&slavePtr](DcpPdu &pdu) {
+        DcpPduView view(pdu.serialize(), pdu.getPduSize());
+        slavePtr->getDcpManager().receive(*view);
+    }));
+    // outputs of the slave are dropped
+    BenchmarkSlave slave(makeSlaveDescription(), makeDriver([&masterPtr](DcpPdu &pdu) {
+        if (pdu.getTypeId() == DcpPduType::DAT_input_output) {
+            sink += pdu.getPduSize();
+            return;
+        }
+        DcpPduView view(pdu.serialize(), pdu.getPduSize());
+        masterPtr->receive(*view);
+    }));
+    slavePtr = &slave;
+    masterPtr = &master;
+
+    std::atomic<int> state(-1);
+    std::atomic<int> nackError(-1);
+    master.setListenerDispatcher(DcpDispatchMode::INLINE);
+    master.setStateChangedNotificationReceivedListener<SYNC>([&state](uint8_t, DcpState newState) {
+        state = (int) newState;
+    });
+    master.setNAckReceivedListener<SYNC>([&nackError](uint8_t, uint16_t, DcpError error) {
+        nackError = (int) error;
+    });
+    auto waitFor = [&state](DcpState expected) {
+        for (int i = 0; i < 2000 && state != (int) expected; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return state == (int) expected;
+    };
+
+    master.STC_register(1, DcpState::ALIVE, convertToUUID("b5279485-720d-4542-9f29-bee4d9a75ef9"),
+                        DcpOpMode::NRT, 1, 0);
+    if (!waitFor(DcpState::CONFIGURATION)) {
+        std::fprintf(stderr, "slave did not register\n");
+        return false;
+    }
+
+    //an output which does not fit into a DAT PDU is rejected
+    master.CFG_time_res(1, 1, 1000);
+    master.CFG_output(1, OVERSIZED_ID + 10, 0, 15);
+    master.CFG_scope(1, OVERSIZED_ID + 10, DcpScope::Initialization_Run_NonRealTime);
+    master.CFG_steps(1, OVERSIZED_ID + 10, 1);
+    master.CFG_target_network_information_UDP(1, OVERSIZED_ID + 10, 0x7f000001, 5001);
+    master.STC_prepare(1, DcpState::CONFIGURATION);
+    for (int i = 0; i < 2000 && nackError == -1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (nackError != (int) DcpError::NOT_SUPPORTED_PDU_SIZE || state != (int) DcpState::CONFIGURATION) {
+        std::fprintf(stderr, "an output of 64 KiB was not rejected\n");
+        return false;
+    }
+    master.CFG_clear(1);
+
+    master.CFG_time_res(1, 1, 1000);
+    master.CFG_input(1, SCALAR_ID, 0, 1, DcpDataType::float64);
+    master.CFG_input(1, SCALAR_ID, 1, 2, DcpDataType::int16);
+    master.CFG_input(1, ARRAY_1K_ID, 0, 3, DcpDataType::float64);
+    master.CFG_input(1, ARRAY_64K_ID, 0, 4, DcpDataType::float64);
+    master.CFG_input(1, STRING_ID, 0, 5, DcpDataType::string);
+    for (uint16_t dataId = SCALAR_ID; dataId <= STRING_ID; dataId++) {
+        master.CFG_scope(1, dataId, DcpScope::Initialization_Run_NonRealTime);
+        master.CFG_steps(1, dataId, 1);
+        master.CFG_source_network_information_UDP(1, dataId, 0x7f000001, 5000);
+    }
+    const uint16_t outputIds[] = {SCALAR_ID + 10, ARRAY_1K_ID + 10, ARRAY_64K_ID + 10};
+    master.CFG_output(1, outputIds[0], 0, 11);
+    master.CFG_output(1, outputIds[0], 1, 12);
+    master.CFG_output(1, outputIds[1], 0, 13);
+    master.CFG_output(1, outputIds[2], 0, 14);
+    for (uint16_t dataId : outputIds) {
+        master.CFG_scope(1, dataId, DcpScope::Initialization_Run_NonRealTime);
+        master.CFG_steps(1, dataId, 1);
+        master.CFG_target_network_information_UDP(1, dataId, 0x7f000001, 5001);
+    }
+    for (uint16_t paramId = SCALAR_ID; paramId <= ARRAY_64K_ID; paramId++) {
+        master.CFG_tunable_parameter(1, paramId, 0, 20 + paramId, DcpDataType::float64);
+        master.CFG_param_network_information_UDP(1, paramId, 0x7f000001, 5002);
+    }
+    master.STC_prepare(1, DcpState::CONFIGURATION);
+    if (!waitFor(DcpState::PREPARED)) {
+        std::fprintf(stderr, "slave did not prepare\n");
+        return false;
+    }
+    master.STC_configure(1, DcpState::PREPARED);
+    if (!waitFor(DcpState::CONFIGURED)) {
+        std::fprintf(stderr, "slave did not configure\n");
+        return false;
+    }
+
+    DcpManager slaveManager = slave.getDcpManager();
+    std::vector<uint8_t> payload(ARRAY_64K_ELEMENTS * 8);
+    fill(payload, DcpDataType::float64, ARRAY_64K_ELEMENTS);
+
+    std::vector<uint8_t> stringPayload(4 + STRING_LENGTH, 's');
+    *((uint32_t *) stringPayload.data()) = STRING_LENGTH;
+    DatCase cases[] = {
+            makeDatCase("DAT_input_output/scalar", new DcpPduDatInputOutput(1, SCALAR_ID, payload.data(), 10)),
+            makeDatCase("DAT_input_output/array1k", new DcpPduDatInputOutput(1, ARRAY_1K_ID, payload.data(),
+                                                                             ARRAY_1K_ELEMENTS * 8)),
+            makeDatCase("DAT_input_output/array64k", new DcpPduDatInputOutput(1, ARRAY_64K_ID, payload.data(),
+                                                                              ARRAY_64K_ELEMENTS * 8)),
+            makeDatCase("DAT_input_output/string", new DcpPduDatInputOutput(1, STRING_ID, stringPayload.data(),
+                                                                            stringPayload.size())),
+            makeDatCase("DAT_parameter/scalar", new DcpPduDatParameter(1, SCALAR_ID, payload.data(), 8)),
+            makeDatCase("DAT_parameter/array1k", new DcpPduDatParameter(1, ARRAY_1K_ID, payload.data(),
+                                                                        ARRAY_1K_ELEMENTS * 8)),
+            makeDatCase("DAT_parameter/array64k", new DcpPduDatParameter(1, ARRAY_64K_ID, payload.data(),
+                                                                         ARRAY_64K_ELEMENTS * 8)),
+    };
+    for (DatCase &datCase : cases) {
+        unsigned char *stream = datCase.pdu->serialize();
+        const size_t size = datCase.pdu->getPduSize();
+        // a fresh sequence id per PDU keeps the slave on the path without missed PDUs
+        uint16_t seq = 1;
+        measure("AbstractDcpManagerSlave::receive", datCase.name, size, [&] {
+            *datCase.seqId = seq++;
+            DcpPduView view(stream, size);
+            slaveManager.receive(*view);
+        });
+        delete datCase.pdu;
+    }
+
+    // the received values are only there if the receive cases ran
+    if (selected("AbstractDcpManagerSlave::receive")) {
+        const float64_t expected = 0.25;
+        if (*slave.getInput<float64_t *>(3) != 0 || slave.getInput<float64_t *>(3)[1] != expected) {
+            std::fprintf(stderr, "DAT_input_output was not applied\n");
+            return false;
+        }
+        if (*slave.getParameter<float64_t *>(22) != 0 || slave.getParameter<float64_t *>(22)[1] != expected) {
+            std::fprintf(stderr, "DAT_parameter was not applied\n");
+            return false;
+        }
+    }
+
+    const std::vector<dataId_t> scalar = {outputIds[0]};
+    const std::vector<dataId_t> array1k = {outputIds[1]};
+    const std::vector<dataId_t> array64k = {outputIds[2]};
+    const std::vector<dataId_t> all = {outputIds[0], outputIds[1], outputIds[2]};
+    measure("DcpManagerSlave::sendOutputs", "scalar", 12, [&] { slave.sendOutputs(scalar); });
+    measure("DcpManagerSlave::sendOutputs", "array1k", ARRAY_1K_ELEMENTS * 8, [&] { slave.sendOutputs(array1k); });
+    measure("DcpManagerSlave::sendOutputs", "array64k", ARRAY_64K_ELEMENTS * 8, [&] {
+        slave.sendOutputs(array64k);
+    });
+    measure("DcpManagerSlave::sendOutputs", "all", 12 + (ARRAY_1K_ELEMENTS + ARRAY_64K_ELEMENTS) * 8, [&] {
+        slave.sendOutputs(all);
+    });
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        minTime = std::strtod(argv[1], nullptr) / 1000;
+    }
+    if (argc > 2) {
+        filter = argv[2];
+    }
+
+    benchmarkMakeDcpPdu();
+    benchmarkMultiDimValue();
+    benchmarkLog();
+    return benchmarkSlave() ? 0 : 1;
+}
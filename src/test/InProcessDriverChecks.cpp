@@ -0,0 +1,220 @@
+//
+// Checks of InProcessDriver
+//
+// - MAILBOX: PDUs of concurrent senders are processed one at a time on the thread calling startReceiving,
+//   the PDUs of each sender in the order they were sent
+// - SYNCHRONOUS: a PDU is processed on the sending thread before send returns. A PDU sent while receiving
+//   does not overwrite the PDU being received
+// - PDUs to an address without endpoint are dropped, an endpoint bound to 0.0.0.0 receives PDUs for every ip
+//
+// the DEBUG log messages of every PDU would flood the output
+#undef DEBUG
+#define LOGGING
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dcp/driver/inprocess/InProcessDriver.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+static const uint32_t LOOPBACK = 0x7f000001;
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        failures++;
+        std::printf("Failed: %s\n", what);
+    }
+}
+
+static void setNetworkInformation(std::function<void(uint16_t, uint8_t *)> set, uint16_t id, uint16_t port,
+                                  uint32_t ip = LOOPBACK) {
+    uint8_t info[6];
+    *((uint16_t *) info) = port;
+    *((ip_address_t *) (info + 2)) = ip;
+    set(id, info);
+}
+
+static void send(DcpDriver &driver, uint16_t dataId, uint32_t value) {
+    DcpPduDatInputOutput pdu(0, dataId, (uint8_t *) &value, sizeof(value));
+    driver.send(pdu);
+}
+
+static uint32_t valueOf(DcpPdu &msg) {
+    uint32_t value;
+    std::memcpy(&value, static_cast<DcpPduDatInputOutput &>(msg).getPayload(), sizeof(value));
+    return value;
+}
+
+static void checkMailbox() {
+    const size_t senderCount = 4;
+    const uint32_t perSender = 2000;
+    const uint16_t dataPort = 9000;
+
+    InProcessNetwork network;
+    std::unique_ptr<InProcessDriver> receiver(
+            new InProcessDriver(network, "127.0.0.1", 8080, InProcessMode::MAILBOX));
+    DcpDriver receiverDriver = receiver->getDcpDriver();
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<uint32_t> last(senderCount, 0);
+    size_t received = 0;
+    bool inOrder = true;
+    std::atomic<int> inManager(0);
+    bool concurrent = false;
+    std::thread::id receivingThread;
+    bool otherThread = false;
+    receiverDriver.setDcpManager({[&](DcpPdu &msg) {
+        if (inManager++ != 0) {
+            concurrent = true;
+        }
+        //data id = sender, payload = 1-based sequence number of the sender
+        const uint16_t sender = static_cast<DcpPduDatInputOutput &>(msg).getDataId();
+        const uint32_t value = valueOf(msg);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            otherThread = otherThread || std::this_thread::get_id() != receivingThread;
+            inOrder = inOrder && sender < senderCount && value == last[sender] + 1;
+            if (sender < senderCount) {
+                last[sender] = value;
+            }
+            received++;
+            cv.notify_all();
+        }
+        inManager--;
+    }, [](const DcpError) {}});
+    for (uint16_t sender = 0; sender < senderCount; sender++) {
+        setNetworkInformation(receiverDriver.setSourceNetworkInformation, sender, dataPort);
+    }
+    receiverDriver.prepare();
+    std::thread mailboxThread([&] {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            receivingThread = std::this_thread::get_id();
+        }
+        receiverDriver.startReceiving();
+    });
+
+    std::vector<std::unique_ptr<InProcessDriver>> senders;
+    std::vector<std::thread> threads;
+    for (uint16_t sender = 0; sender < senderCount; sender++) {
+        senders.emplace_back(new InProcessDriver(network, "127.0.0.1", 8100 + sender, InProcessMode::MAILBOX));
+    }
+    for (uint16_t sender = 0; sender < senderCount; sender++) {
+        threads.emplace_back([&, sender] {
+            DcpDriver driver = senders[sender]->getDcpDriver();
+            setNetworkInformation(driver.setTargetNetworkInformation, sender, dataPort);
+            for (uint32_t i = 1; i <= perSender; i++) {
+                send(driver, sender, i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        check(cv.wait_for(lock, std::chrono::seconds(5), [&] { return received == senderCount * perSender; }),
+              "the mailbox delivers every PDU");
+        check(inOrder, "the mailbox keeps the order of the PDUs of each sender");
+        check(!otherThread, "the mailbox is processed on the thread calling startReceiving");
+    }
+    check(!concurrent, "the mailbox passes one PDU at a time to the manager");
+
+    //the destructor stops the mailbox, startReceiving returns
+    receiver.reset();
+    mailboxThread.join();
+}
+
+static void checkSynchronous() {
+    const uint16_t dataPort = 9000;
+    const uint16_t replyPort = 9001;
+
+    InProcessNetwork network;
+    InProcessDriver sender(network, "127.0.0.1", 8000);
+    InProcessDriver receiver(network, "127.0.0.1", 8080);
+    DcpDriver senderDriver = sender.getDcpDriver();
+    DcpDriver receiverDriver = receiver.getDcpDriver();
+
+    std::vector<uint32_t> received;
+    std::vector<uint32_t> replies;
+    bool otherThread = false;
+    bool payloadKept = true;
+    const std::thread::id sendingThread = std::this_thread::get_id();
+    receiverDriver.setDcpManager({[&](DcpPdu &msg) {
+        otherThread = otherThread || std::this_thread::get_id() != sendingThread;
+        const uint32_t value = valueOf(msg);
+        received.push_back(value);
+        //answer while receiving, the answer is received on this thread as well
+        send(receiverDriver, 2, value + 1000);
+        payloadKept = payloadKept && valueOf(msg) == value;
+    }, [](const DcpError) {}});
+    senderDriver.setDcpManager({[&](DcpPdu &msg) {
+        replies.push_back(valueOf(msg));
+    }, [](const DcpError) {}});
+
+    setNetworkInformation(receiverDriver.setSourceNetworkInformation, 1, dataPort);
+    setNetworkInformation(receiverDriver.setTargetNetworkInformation, 2, replyPort);
+    setNetworkInformation(senderDriver.setSourceNetworkInformation, 2, replyPort);
+    setNetworkInformation(senderDriver.setTargetNetworkInformation, 1, dataPort);
+    receiverDriver.startReceiving();
+    senderDriver.startReceiving();
+    receiverDriver.prepare();
+    senderDriver.prepare();
+
+    bool immediate = true;
+    for (uint32_t i = 0; i < 100; i++) {
+        send(senderDriver, 1, i);
+        immediate = immediate && received.size() == i + 1 && replies.size() == i + 1 && replies[i] == i + 1000;
+    }
+    check(immediate, "a synchronous PDU and its answer are received before send returns");
+    check(!otherThread, "a synchronous PDU is received on the sending thread");
+    check(payloadKept, "a PDU sent while receiving does not overwrite the PDU being received");
+
+    //without an endpoint the PDU is lost like a datagram
+    setNetworkInformation(senderDriver.setTargetNetworkInformation, 3, dataPort + 10);
+    send(senderDriver, 3, 0);
+    check(received.size() == 100, "a PDU to an address without endpoint is dropped");
+
+    //stop unbinds the data ports
+    receiverDriver.stop();
+    send(senderDriver, 1, 0);
+    check(received.size() == 100, "a PDU to a closed port is dropped");
+}
+
+static void checkWildcard() {
+    InProcessNetwork network;
+    InProcessDriver sender(network, "127.0.0.1", 8000);
+    InProcessDriver receiver(network, "0.0.0.0", 8080);
+    DcpDriver senderDriver = sender.getDcpDriver();
+    DcpDriver receiverDriver = receiver.getDcpDriver();
+
+    size_t received = 0;
+    receiverDriver.setDcpManager({[&](DcpPdu &) { received++; }, [](const DcpError) {}});
+    senderDriver.setDcpManager({[](DcpPdu &) {}, [](const DcpError) {}});
+    receiverDriver.startReceiving();
+
+    DcpPduBasic control(DcpPduType::STC_deregister, 0, 1);
+    setNetworkInformation(senderDriver.setSlaveNetworkInformation, 1, 8080, 0x0a000001);
+    senderDriver.send(control);
+    setNetworkInformation(senderDriver.setSlaveNetworkInformation, 1, 8080);
+    senderDriver.send(control);
+    check(received == 2, "an endpoint bound to 0.0.0.0 receives PDUs addressed to any ip");
+}
+
+int main() {
+    checkMailbox();
+    checkSynchronous();
+    checkWildcard();
+    std::printf("in-process driver checks done, %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
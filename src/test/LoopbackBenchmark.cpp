@@ -0,0 +1,341 @@
+//
+// End-to-end loopback benchmark of a DcpManagerMaster and several DcpManagerSlaves
+//
+// All managers communicate through UdpDriver or TcpDriver on 127.0.0.1. The slaves are registered,
+// configured and started in operation mode NRT, afterwards two measurements are taken:
+// - latency: the master sends STC_do_step to all slaves and answers their NTF_state_changed (COMPUTED)
+//   with STC_send_outputs. Measured is the time from STC_do_step to the DAT_input_output of the slave
+//   arriving at the master.
+// - rate: the master sends DAT_input_output PDUs to the inputs of all slaves as fast as possible.
+//   Measured is the number of PDUs each slave received.
+//
+// usage: loopbackBenchmark [udp|tcp] [slaves] [steps] [rate duration in ms]
+//
+// the DEBUG log messages of the receive and send path would dominate the measurement
+#undef DEBUG
+#define LOGGING
+
+#define ASIO_STANDALONE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dcp/driver/ethernet/tcp/TcpDriver.hpp>
+#include <dcp/driver/ethernet/udp/UdpDriver.hpp>
+#include <dcp/logic/DcpManagerMaster.hpp>
+#include <dcp/logic/DcpManagerSlave.hpp>
+
+using namespace std::chrono;
+
+static const uint32_t LOOPBACK = 0x7f000001;
+static const uint16_t MASTER_PORT = 18000;
+// slave i listens on CONTROL_PORT + i, its inputs on INPUT_PORT + i, the master receives its outputs on OUTPUT_PORT + i
+static const uint16_t CONTROL_PORT = 18100;
+static const uint16_t OUTPUT_PORT = 18200;
+static const uint16_t INPUT_PORT = 18300;
+// the outputs of slave i have data id i, its inputs INPUT_DATA_ID + i
+static const uint16_t INPUT_DATA_ID = 100;
+static const valueReference_t OUTPUT_VR = 1;
+static const valueReference_t INPUT_VR = 2;
+
+static std::string slaveUuid(uint8_t dcpId) {
+    char uuid[37];
+    std::snprintf(uuid, sizeof(uuid), "b5279485-720d-4542-9f29-bee4d9a75e%02x", dcpId);
+    return uuid;
+}
+
+static SlaveDescription_t makeSlaveDescription(uint8_t dcpId, bool tcp) {
+    SlaveDescription_t slaveDescription = make_SlaveDescription(1, 0, "dcpslave", slaveUuid(dcpId));
+    slaveDescription.OpMode.NonRealTime = make_NonRealTime_ptr();
+    Resolution_t resolution = make_Resolution();
+    resolution.numerator = 1;
+    resolution.denominator = 1000;
+    slaveDescription.TimeRes.resolutions.push_back(resolution);
+    std::shared_ptr<Ethernet_t> ethernet = tcp ? make_TCP_ptr() : make_UDP_ptr();
+    ethernet->Control = make_Control_ptr("127.0.0.1", CONTROL_PORT + dcpId);
+    ethernet->DAT_input_output = make_DAT_ptr();
+    ethernet->DAT_input_output->availablePortRanges.push_back(make_AviablePortRange(2048, 65535));
+    ethernet->DAT_parameter = make_DAT_ptr();
+    ethernet->DAT_parameter->availablePortRanges.push_back(make_AviablePortRange(2048, 65535));
+    if (tcp) {
+        slaveDescription.TransportProtocols.TCP_IPv4 = ethernet;
+    } else {
+        slaveDescription.TransportProtocols.UDP_IPv4 = ethernet;
+    }
+    slaveDescription.CapabilityFlags.canAcceptConfigPdus = true;
+    slaveDescription.CapabilityFlags.canHandleVariableSteps = true;
+
+    slaveDescription.Variables.push_back(make_Variable_output("y", OUTPUT_VR, make_Output_ptr<float64_t>()));
+    slaveDescription.Variables.push_back(make_Variable_input("a", INPUT_VR, make_CommonCausality_ptr<float64_t>()));
+    return slaveDescription;
+}
+
+static DcpDriver makeDriver(bool tcp, uint16_t port) {
+    //the drivers can not be stopped, their receiving threads run until the process exits
+    if (tcp) {
+        return (new TcpDriver("127.0.0.1", port))->getDcpDriver();
+    }
+    return (new UdpDriver("127.0.0.1", port))->getDcpDriver();
+}
+
+/**
+ * Count the DAT_input_output PDUs the driver passes to its DcpManager.
+ */
+static DcpDriver countReceivedData(DcpDriver driver, std::atomic<size_t> &received) {
+    std::function<void(DcpManager)> setDcpManager = driver.setDcpManager;
+    driver.setDcpManager = [setDcpManager, &received](DcpManager manager) {
+        std::function<void(DcpPdu &)> receive = manager.receive;
+        manager.receive = [receive, &received](DcpPdu &pdu) {
+            if (pdu.getTypeId() == DcpPduType::DAT_input_output) {
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+            receive(pdu);
+        };
+        setDcpManager(manager);
+    };
+    return driver;
+}
+
+static void setNetworkInformation(std::function<void(uint16_t, uint8_t *)> set, uint16_t id, uint16_t port) {
+    uint8_t info[6];
+    *((uint16_t *) info) = port;
+    *((ip_address_t *) (info + 2)) = LOOPBACK;
+    set(id, info);
+}
+
+static void printLatencies(const char *name, std::vector<double> &latencies) {
+    if (latencies.empty()) {
+        std::printf("%-8s no samples\n", name);
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, (size_t) (latencies.size() * p))];
+    };
+    std::printf("%-8s min %8.1f  p50 %8.1f  p90 %8.1f  p99 %8.1f  p99.9 %8.1f  max %8.1f us\n", name,
+                latencies.front(), percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999),
+                latencies.back());
+}
+
+int main(int argc, char *argv[]) {
+    const bool tcp = argc > 1 && std::string(argv[1]) == "tcp";
+    const uint8_t slaves = (uint8_t) std::max(1, std::min(99, argc > 2 ? std::atoi(argv[2]) : 1));
+    const size_t steps = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000;
+    const double rateDuration = (argc > 4 ? std::strtod(argv[4], nullptr) : 1000) / 1000;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    // indexed by dcp id and data id of the outputs, which are the same
+    std::vector<DcpState> states(slaves + 1, DcpState::ALIVE);
+    std::vector<bool> outputReceived(slaves + 1, false);
+    std::vector<std::vector<double>> latencies(slaves + 1);
+    std::vector<std::atomic<size_t>> received(slaves + 1);
+    steady_clock::time_point stepStart;
+    bool measuring = false;
+    std::atomic<size_t> nacks(0);
+
+    DcpDriver masterDriver = makeDriver(tcp, MASTER_PORT);
+    DcpManagerMaster *master = new DcpManagerMaster(masterDriver);
+    std::vector<DcpManagerSlave *> slaveManagers(slaves + 1, nullptr);
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        DcpManagerSlave *slave = new DcpManagerSlave(makeSlaveDescription(dcpId, tcp),
+                                                     countReceivedData(makeDriver(tcp, CONTROL_PORT + dcpId),
+                                                                       received[dcpId]));
+        slave->setSynchronizingNRTStepCallback<SYNC>([slave](uint64_t) {
+            *slave->getOutput<float64_t *>(OUTPUT_VR) = *slave->getInput<float64_t *>(INPUT_VR) * 2;
+        });
+        slaveManagers[dcpId] = slave;
+        setNetworkInformation(masterDriver.setSlaveNetworkInformation, dcpId, CONTROL_PORT + dcpId);
+    }
+
+    master->setListenerDispatcher(DcpDispatchMode::INLINE);
+    master->setStateChangedNotificationReceivedListener<SYNC>([&](uint8_t dcpId, DcpState state) {
+        if (dcpId == 0 || dcpId > slaves) {
+            return;
+        }
+        if (state == DcpState::COMPUTED) {
+            master->STC_send_outputs(dcpId, DcpState::COMPUTED);
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        states[dcpId] = state;
+        cv.notify_all();
+    });
+    master->setDataReceivedListener<SYNC>([&](uint16_t dataId, size_t, uint8_t *) {
+        const steady_clock::time_point now = steady_clock::now();
+        if (dataId == 0 || dataId > slaves) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        if (measuring) {
+            latencies[dataId].push_back(duration_cast<duration<double, std::micro>>(now - stepStart).count());
+        }
+        outputReceived[dataId] = true;
+        cv.notify_all();
+    });
+    master->setNAckReceivedListener<SYNC>([&](uint8_t dcpId, uint16_t, DcpError error) {
+        nacks++;
+        std::fprintf(stderr, "slave %u sent NACK with error %s\n", dcpId, to_string(error).c_str());
+    });
+
+    auto waitFor = [&](std::function<bool(uint8_t)> condition, const char *what) {
+        std::unique_lock<std::mutex> lock(mtx);
+        const bool reached = cv.wait_for(lock, seconds(5), [&] {
+            for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+                if (!condition(dcpId)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        if (!reached) {
+            std::fprintf(stderr, "timeout while waiting for %s\n", what);
+        }
+        return reached;
+    };
+    auto inState = [&](DcpState state) {
+        return [&states, state](uint8_t dcpId) { return states[dcpId] == state; };
+    };
+
+    for (DcpManagerSlave *slave : slaveManagers) {
+        if (slave != nullptr) {
+            std::thread(&DcpManagerSlave::start, slave).detach();
+        }
+    }
+    std::thread(&DcpManagerMaster::start, master).detach();
+    std::this_thread::sleep_for(milliseconds(100));
+    //the ports for the outputs can only be added once the driver is receiving
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        setNetworkInformation(masterDriver.setSourceNetworkInformation, dcpId, OUTPUT_PORT + dcpId);
+    }
+    masterDriver.prepare();
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        if (tcp) {
+            masterDriver.connectToSlave(dcpId);
+        }
+        master->STC_register(dcpId, DcpState::ALIVE, convertToUUID(slaveUuid(dcpId)), DcpOpMode::NRT, 1, 0);
+    }
+    if (!waitFor(inState(DcpState::CONFIGURATION), "CONFIGURATION")) {
+        return 1;
+    }
+
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        const uint16_t inputId = INPUT_DATA_ID + dcpId;
+        master->CFG_time_res(dcpId, 1, 1000);
+        master->CFG_scope(dcpId, dcpId, DcpScope::Initialization_Run_NonRealTime);
+        master->CFG_scope(dcpId, inputId, DcpScope::Initialization_Run_NonRealTime);
+        master->CFG_output(dcpId, dcpId, 0, OUTPUT_VR);
+        master->CFG_steps(dcpId, dcpId, 1);
+        master->CFG_input(dcpId, inputId, 0, INPUT_VR, DcpDataType::float64);
+        if (tcp) {
+            master->CFG_target_network_information_TCP(dcpId, dcpId, LOOPBACK, OUTPUT_PORT + dcpId);
+            master->CFG_source_network_information_TCP(dcpId, inputId, LOOPBACK, INPUT_PORT + dcpId);
+        } else {
+            master->CFG_target_network_information_UDP(dcpId, dcpId, LOOPBACK, OUTPUT_PORT + dcpId);
+            master->CFG_source_network_information_UDP(dcpId, inputId, LOOPBACK, INPUT_PORT + dcpId);
+        }
+        setNetworkInformation(masterDriver.setTargetNetworkInformation, inputId, INPUT_PORT + dcpId);
+        master->STC_prepare(dcpId, DcpState::CONFIGURATION);
+    }
+    if (!waitFor(inState(DcpState::PREPARED), "PREPARED")) {
+        return 1;
+    }
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        master->STC_configure(dcpId, DcpState::PREPARED);
+    }
+    if (!waitFor(inState(DcpState::CONFIGURED), "CONFIGURED")) {
+        return 1;
+    }
+    masterDriver.configure();
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        master->STC_run(dcpId, DcpState::CONFIGURED, 0);
+    }
+    //in NRT the slaves step in SYNCHRONIZING until they are synchronized
+    if (!waitFor(inState(DcpState::SYNCHRONIZING), "SYNCHRONIZING")) {
+        return 1;
+    }
+
+    // the first steps are not measured
+    const size_t warmUp = std::min<size_t>(100, steps);
+    for (size_t step = 0; step < warmUp + steps; step++) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            std::fill(outputReceived.begin(), outputReceived.end(), false);
+            measuring = step >= warmUp;
+            stepStart = steady_clock::now();
+        }
+        for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+            master->STC_do_step(dcpId, DcpState::SYNCHRONIZING, 1);
+        }
+        if (!waitFor([&](uint8_t dcpId) {
+            return outputReceived[dcpId] && states[dcpId] == DcpState::SYNCHRONIZING;
+        }, "DAT_input_output after STC_do_step")) {
+            return 1;
+        }
+    }
+
+    std::printf("%s, %u slave(s), %zu steps\n", tcp ? "tcp" : "udp", slaves, steps);
+    std::printf("STC_do_step -> DAT_input_output latency\n");
+    std::vector<double> all;
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        all.insert(all.end(), latencies[dcpId].begin(), latencies[dcpId].end());
+        printLatencies(("slave " + std::to_string(dcpId)).c_str(), latencies[dcpId]);
+    }
+    if (slaves > 1) {
+        printLatencies("all", all);
+    }
+
+    std::vector<size_t> sent(slaves + 1, 0);
+    std::vector<size_t> receivedBefore(slaves + 1, 0);
+    std::vector<size_t> receivedInTime(slaves + 1, 0);
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        receivedBefore[dcpId] = received[dcpId];
+    }
+    float64_t value = 0;
+    const steady_clock::time_point rateStart = steady_clock::now();
+    const steady_clock::time_point rateEnd = rateStart + duration_cast<steady_clock::duration>(
+            duration<double>(rateDuration));
+    while (steady_clock::now() < rateEnd) {
+        //check the clock every 64 PDUs per slave
+        for (size_t i = 0; i < 64; i++) {
+            value++;
+            for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+                master->DAT_input_output(INPUT_DATA_ID + dcpId, (uint8_t *) &value, sizeof(value));
+                sent[dcpId]++;
+            }
+        }
+    }
+    const double elapsed = duration_cast<duration<double>>(steady_clock::now() - rateStart).count();
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        receivedInTime[dcpId] = received[dcpId] - receivedBefore[dcpId];
+    }
+    //PDUs which are still in flight or queued in the socket buffers are not lost, wait until nothing arrives anymore
+    size_t inFlight;
+    do {
+        inFlight = 0;
+        for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+            inFlight += received[dcpId];
+        }
+        std::this_thread::sleep_for(milliseconds(200));
+        for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+            inFlight -= received[dcpId];
+        }
+    } while (inFlight != 0);
+
+    std::printf("DAT_input_output rate\n");
+    for (uint8_t dcpId = 1; dcpId <= slaves; dcpId++) {
+        const size_t total = received[dcpId] - receivedBefore[dcpId];
+        std::printf("slave %-2u sent %10zu  received %10zu  %12.0f PDU/s  lost %zu\n", dcpId, sent[dcpId],
+                    total, receivedInTime[dcpId] / elapsed, sent[dcpId] - std::min(sent[dcpId], total));
+    }
+
+    return nacks == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+//
+// Checks that receiving DAT_input_output PDUs through a DcpPduView does not allocate
+//
+// the DEBUG log messages of the receive path allocate, LOGGING keeps the log infrastructure
+#undef DEBUG
+#define LOGGING
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include <dcp/logic/DcpManagerSlave.hpp>
+#include <dcp/logic/DcpManagerMaster.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+static std::atomic<size_t> allocations(0);
+
+void *operator new(size_t size) {
+    allocations++;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+static DcpDriver makeDriver(std::function<void(DcpPdu &)> send) {
+    DcpDriver driver;
+    driver.send = send;
+    driver.setSlaveNetworkInformation = [](dcpId_t, uint8_t *) {};
+    driver.setSourceNetworkInformation = [](dataId_t, uint8_t *) {};
+    driver.setTargetNetworkInformation = [](dataId_t, uint8_t *) {};
+    driver.setParamNetworkInformation = [](paramId_t, uint8_t *) {};
+    driver.setTargetParamNetworkInformation = [](paramId_t, uint8_t *) {};
+    driver.startReceiving = [] {};
+    driver.connectToSlave = [](dcpId_t) {};
+    driver.disconnectFromSlave = [](dcpId_t) {};
+    driver.setDcpManager = [](DcpManager) {};
+    driver.setLogManager = [](LogManager) {};
+    driver.registerSuccessfull = [] {};
+    driver.prepare = [] {};
+    driver.configure = [] {};
+    driver.stop = [] {};
+    driver.disconnect = [] {};
+    return driver;
+}
+
+static SlaveDescription_t makeSlaveDescription() {
+    SlaveDescription_t slaveDescription = make_SlaveDescription(1, 0, "dcpslave",
+                                                                "b5279485-720d-4542-9f29-bee4d9a75ef9");
+    slaveDescription.OpMode.NonRealTime = make_NonRealTime_ptr();
+    Resolution_t resolution = make_Resolution();
+    resolution.numerator = 1;
+    resolution.denominator = 1000;
+    slaveDescription.TimeRes.resolutions.push_back(resolution);
+    slaveDescription.TransportProtocols.UDP_IPv4 = make_UDP_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->Control = make_Control_ptr("127.0.0.1", 8080);
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_input_output = make_DAT_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_input_output->availablePortRanges.push_back(
+            make_AviablePortRange(2048, 65535));
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_parameter = make_DAT_ptr();
+    slaveDescription.TransportProtocols.UDP_IPv4->DAT_parameter->availablePortRanges.push_back(
+            make_AviablePortRange(2048, 65535));
+    slaveDescription.CapabilityFlags.canAcceptConfigPdus = true;
+    slaveDescription.CapabilityFlags.canHandleVariableSteps = true;
+
+    std::shared_ptr<CommonCausality_t> a = make_CommonCausality_ptr<float64_t>();
+    slaveDescription.Variables.push_back(make_Variable_input("a", 1, a));
+    std::shared_ptr<CommonCausality_t> b = make_CommonCausality_ptr<int32_t>();
+    slaveDescription.Variables.push_back(make_Variable_input("b", 2, b));
+    return slaveDescription;
+}
+
+int main() {
+    DcpManagerSlave *slavePtr = nullptr;
+    DcpManagerMaster *masterPtr = nullptr;
+    // PDUs are passed between master and slave as raw bytes, like a driver does
+    DcpManagerMaster master(makeDriver([&slavePtr](DcpPdu &pdu) {
+        DcpPduView view(pdu.serialize(), pdu.getPduSize());
+        slavePtr->getDcpManager().receive(*view);
+    }));
+    DcpManagerSlave slave(makeSlaveDescription(), makeDriver([&masterPtr](DcpPdu &pdu) {
+        DcpPduView view(pdu.serialize(), pdu.getPduSize());
+        masterPtr->receive(*view);
+    }));
+    slavePtr = &slave;
+    masterPtr = &master;
+
+    std::atomic<int> state(-1);
+    master.setListenerDispatcher(DcpDispatchMode::INLINE);
+    master.setStateChangedNotificationReceivedListener<SYNC>([&state](uint8_t, DcpState newState) {
+        state = (int) newState;
+    });
+    auto waitFor = [&state](DcpState expected) {
+        for (int i = 0; i < 2000 && state != (int) expected; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return state == (int) expected;
+    };
+
+    master.STC_register(1, DcpState::ALIVE, convertToUUID("b5279485-720d-4542-9f29-bee4d9a75ef9"),
+                        DcpOpMode::NRT, 1, 0);
+    if (!waitFor(DcpState::CONFIGURATION)) {
+        std::printf("slave did not register\n");
+        return 1;
+    }
+    master.CFG_scope(1, 1, DcpScope::Initialization_Run_NonRealTime);
+    master.CFG_input(1, 1, 0, 1, DcpDataType::float64);
+    master.CFG_input(1, 1, 1, 2, DcpDataType::int16);
+    master.CFG_steps(1, 1, 1);
+    master.CFG_time_res(1, 1, 1000);
+    master.CFG_source_network_information_UDP(1, 1, 0x7f000001, 5000);
+    master.STC_prepare(1, DcpState::CONFIGURATION);
+    if (!waitFor(DcpState::PREPARED)) {
+        std::printf("slave did not prepare\n");
+        return 1;
+    }
+    master.STC_configure(1, DcpState::PREPARED);
+    if (!waitFor(DcpState::CONFIGURED)) {
+        std::printf("slave did not configure\n");
+        return 1;
+    }
+
+    float64_t *a = slave.getInput<float64_t *>(1);
+    int32_t *b = slave.getInput<int32_t *>(2);
+    DcpManager slaveManager = slave.getDcpManager();
+    DcpPduDatInputOutput data(0, 1, 10);
+
+    const uint16_t iterations = 10000;
+    size_t allocated = 0;
+    int failures = 0;
+    for (uint16_t seq = 1; seq <= iterations; seq++) {
+        const float64_t expectedA = seq * 0.5;
+        const int16_t expectedB = (int16_t) -seq;
+        data.getPduSeqId() = seq;
+        std::memcpy(data.getPayload(), &expectedA, 8);
+        std::memcpy(data.getPayload() + 8, &expectedB, 2);
+
+        const size_t before = allocations;
+        {
+            DcpPduView view(data.serialize(), data.getPduSize());
+            slaveManager.receive(*view);
+        }
+        // the first PDU of a data id may initialize the sequence number bookkeeping
+        if (seq > 1) {
+            allocated += allocations - before;
+        }
+        if (*a != expectedA || *b != expectedB) {
+            failures++;
+        }
+    }
+
+    std::printf("%u DAT_input_output PDUs received, %zu allocations, %d wrong values\n", iterations, allocated,
+                failures);
+    return allocated == 0 && failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+//
+// Checks of the shared-memory ring and of ShmDriver
+//
+// - ShmRing: a full ring rejects acquire until the consumer pops, indices wrap around the slots, discard drops
+//   what a previous run left, producer and consumer may map the ring independently
+// - ShmDriver: DAT_input_output PDUs to a local address pass the ring in order across many wrap-arounds,
+//   PDUs sent while the ring is full are dropped, all other PDUs are passed to the wrapped driver
+//
+// the DEBUG log messages of every PDU would flood the output
+#undef DEBUG
+#define LOGGING
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <dcp/driver/ethernet/shm/ShmDriver.hpp>
+#include <dcp/model/pdu/DcpPduFactory.hpp>
+
+static const uint32_t LOOPBACK = 0x7f000001;
+static const uint32_t SLOT_COUNT = 8;
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        failures++;
+        std::printf("Failed: %s\n", what);
+    }
+}
+
+static std::string ringName(const char *check) {
+    return "/dcplib_check_" + std::to_string(getpid()) + "_" + check;
+}
+
+static void checkFullRing() {
+    ShmRing producer(ringName("full"), SLOT_COUNT);
+    ShmRing consumer(ringName("full"), SLOT_COUNT);
+    producer.unlink();
+
+    check(consumer.front() == nullptr, "a new ring is empty");
+    uint8_t *first = producer.acquire();
+    check(first != nullptr && producer.acquire() == first, "acquire returns the same slot until it is published");
+    for (uint32_t i = 0; i < SLOT_COUNT; i++) {
+        uint8_t *slot = producer.acquire();
+        if (slot == nullptr) {
+            check(false, "a ring with free slots accepts a PDU");
+            return;
+        }
+        std::memcpy(slot, &i, sizeof(i));
+        producer.publish();
+    }
+    check(producer.acquire() == nullptr, "a full ring rejects acquire");
+
+    uint32_t value = 0;
+    std::memcpy(&value, consumer.front(), sizeof(value));
+    check(value == 0, "the consumer sees the oldest slot first");
+    consumer.pop();
+    check(producer.acquire() == first, "a popped slot is reused by the producer");
+
+    consumer.discard();
+    check(consumer.front() == nullptr, "discard drops all published slots");
+}
+
+static void checkWrapAround() {
+    ShmRing producer(ringName("wrap"), SLOT_COUNT);
+    ShmRing consumer(ringName("wrap"), SLOT_COUNT);
+    producer.unlink();
+
+    //bursts of 1 to SLOT_COUNT slots, so the ring wraps around at every fill level
+    const uint32_t total = SLOT_COUNT * 50 + 3;
+    uint32_t produced = 0;
+    uint32_t expected = 0;
+    bool inOrder = true;
+    for (uint32_t round = 0; expected < total; round++) {
+        const uint32_t burst = 1 + round % SLOT_COUNT;
+        for (uint32_t i = 0; i < burst && produced < total; i++) {
+            uint8_t *slot = producer.acquire();
+            if (slot == nullptr) {
+                break;
+            }
+            std::memcpy(slot, &produced, sizeof(produced));
+            producer.publish();
+            produced++;
+        }
+        uint8_t *slot;
+        while ((slot = consumer.front()) != nullptr) {
+            uint32_t value;
+            std::memcpy(&value, slot, sizeof(value));
+            inOrder = inOrder && value == expected;
+            expected++;
+            consumer.pop();
+        }
+    }
+    check(inOrder, "slots are consumed in the order they were published across wrap-arounds");
+    check(produced == total, "all slots were published");
+}
+
+/**
+ * Wrapped driver which records the PDUs and network information passed to it
+ */
+struct TransportRecorder {
+    std::vector<DcpPduType> sent;
+    std::vector<dataId_t> targets;
+
+    DcpDriver getDcpDriver() {
+        DcpDriver driver;
+        driver.send = [this](DcpPdu &msg) { sent.push_back(msg.getTypeId()); };
+        driver.setSlaveNetworkInformation = [](dcpId_t, uint8_t *) {};
+        driver.setSourceNetworkInformation = [](dataId_t, uint8_t *) {};
+        driver.setTargetNetworkInformation = [this](dataId_t dataId, uint8_t *) { targets.push_back(dataId); };
+        driver.setParamNetworkInformation = [](paramId_t, uint8_t *) {};
+        driver.setTargetParamNetworkInformation = [](paramId_t, uint8_t *) {};
+        driver.startReceiving = []() {};
+        driver.connectToSlave = [](dcpId_t) {};
+        driver.disconnectFromSlave = [](dcpId_t) {};
+        driver.setDcpManager = [](DcpManager) {};
+        driver.setLogManager = [](LogManager) {};
+        driver.registerSuccessfull = []() {};
+        driver.prepare = []() {};
+        driver.configure = []() {};
+        driver.stop = []() {};
+        driver.disconnect = []() {};
+        return driver;
+    }
+};
+
+static void setNetworkInformation(std::function<void(uint16_t, uint8_t *)> set, uint16_t id, uint16_t port,
+                                  uint32_t ip = LOOPBACK) {
+    uint8_t info[6];
+    *((uint16_t *) info) = port;
+    *((ip_address_t *) (info + 2)) = ip;
+    set(id, info);
+}
+
+static void send(DcpDriver &driver, uint16_t dataId, uint32_t value) {
+    DcpPduDatInputOutput pdu(0, dataId, (uint8_t *) &value, sizeof(value));
+    driver.send(pdu);
+}
+
+static void checkDriver() {
+    const uint16_t port = (uint16_t) (20000 + getpid() % 20000);
+    const uint16_t dataId = 7;
+
+    TransportRecorder senderTransport;
+    TransportRecorder receiverTransport;
+    ShmDriver sender(senderTransport.getDcpDriver(), SLOT_COUNT);
+    ShmDriver receiver(receiverTransport.getDcpDriver(), SLOT_COUNT);
+    DcpDriver senderDriver = sender.getDcpDriver();
+    DcpDriver receiverDriver = receiver.getDcpDriver();
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<uint32_t> received;
+    bool blocked = false;
+    bool release = true;
+    senderDriver.setDcpManager({[](DcpPdu &) {}, [](const DcpError) {}});
+    receiverDriver.setDcpManager({[&](DcpPdu &msg) {
+        if (msg.getTypeId() != DcpPduType::DAT_input_output) {
+            return;
+        }
+        uint32_t value;
+        std::memcpy(&value, static_cast<DcpPduDatInputOutput &>(msg).getPayload(), sizeof(value));
+        std::unique_lock<std::mutex> lock(mtx);
+        received.push_back(value);
+        blocked = !release;
+        cv.notify_all();
+        cv.wait(lock, [&] { return release; });
+    }, [](const DcpError) {}});
+    auto waitForReceived = [&](size_t count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&] { return received.size() >= count; });
+    };
+
+    setNetworkInformation(receiverDriver.setSourceNetworkInformation, dataId, port);
+    receiverDriver.prepare();
+    setNetworkInformation(senderDriver.setTargetNetworkInformation, dataId, port);
+    check(senderTransport.targets.empty(), "a local target is not passed to the wrapped driver");
+
+    //one PDU at a time, the ring wraps around many times
+    const uint32_t total = SLOT_COUNT * 20;
+    bool complete = true;
+    for (uint32_t i = 0; i < total && complete; i++) {
+        send(senderDriver, dataId, i);
+        complete = waitForReceived(i + 1);
+    }
+    check(complete, "every PDU sent through the ring is received");
+    bool inOrder = received.size() == total;
+    for (uint32_t i = 0; inOrder && i < total; i++) {
+        inOrder = received[i] == i;
+    }
+    check(inOrder, "PDUs are received in the order they were sent");
+
+    //the reader blocks in the manager on the first PDU, it keeps its slot until the manager returns
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        received.clear();
+        release = false;
+    }
+    send(senderDriver, dataId, 0);
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait_for(lock, std::chrono::seconds(5), [&] { return blocked; });
+    }
+    for (uint32_t i = 1; i < SLOT_COUNT + 4; i++) {
+        send(senderDriver, dataId, i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        release = true;
+        cv.notify_all();
+    }
+    check(waitForReceived(SLOT_COUNT), "the PDUs which fit into the ring are received");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        bool dropped = received.size() == SLOT_COUNT;
+        for (uint32_t i = 0; dropped && i < SLOT_COUNT; i++) {
+            dropped = received[i] == i;
+        }
+        check(dropped, "PDUs sent while the ring is full are dropped, the others are kept in order");
+        received.clear();
+    }
+    send(senderDriver, dataId, 42);
+    check(waitForReceived(1) && received[0] == 42, "the ring accepts PDUs again once the reader caught up");
+
+    //control PDUs and DAT_input_output PDUs to other hosts use the wrapped driver
+    DcpPduBasic control(DcpPduType::STC_deregister, 1, 1);
+    senderDriver.send(control);
+    setNetworkInformation(senderDriver.setTargetNetworkInformation, dataId + 1, port, 0x0a000001);
+    send(senderDriver, dataId + 1, 0);
+    check(senderTransport.targets.size() == 1 && senderTransport.targets[0] == dataId + 1,
+          "a remote target is passed to the wrapped driver");
+    check(senderTransport.sent.size() == 2 && senderTransport.sent[0] == DcpPduType::STC_deregister &&
+          senderTransport.sent[1] == DcpPduType::DAT_input_output,
+          "control PDUs and PDUs to remote targets are sent by the wrapped driver");
+
+    receiverDriver.stop();
+}
+
+int main() {
+    checkFullRing();
+    checkWrapAround();
+    checkDriver();
+    std::printf("shared-memory driver checks done, %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+//
+// Loopback benchmark of the asio based UdpDriver against the io_uring based UdpUringDriver
+//
+// A client socket sends DAT_input_output PDUs to the control port of a driver, which echoes each PDU back.
+// Reports the echo rate with several PDUs in flight and the round trip latency of single PDUs.
+//
+// the DEBUG log messages of the receive and send path would dominate the measurement
+#undef DEBUG
+#define LOGGING
+
+#define ASIO_STANDALONE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <dcp/driver/ethernet/udp/UdpDriver.hpp>
+#include <dcp/driver/ethernet/udp/UdpUringDriver.hpp>
+
+using namespace std::chrono;
+
+static const dataId_t BENCHMARK_DATA_ID = 1;
+
+struct BenchmarkResult {
+    size_t echoed;
+    size_t lost;
+    double pdusPerSecond;
+    double p50;
+    double p99;
+};
+
+class Client {
+public:
+    Client(uint16_t driverPort) {
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in local;
+        std::memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd, (sockaddr *) &local, sizeof(local));
+        socklen_t length = sizeof(local);
+        getsockname(fd, (sockaddr *) &local, &length);
+        port = ntohs(local.sin_port);
+
+        timeval timeout = {0, 200000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        std::memset(&driver, 0, sizeof(driver));
+        driver.sin_family = AF_INET;
+        driver.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        driver.sin_port = htons(driverPort);
+    }
+
+    ~Client() {
+        close(fd);
+    }
+
+    void send(uint16_t seq) {
+        uint64_t payload = 0;
+        DcpPduDatInputOutput pdu(seq, BENCHMARK_DATA_ID, (uint8_t *) &payload, sizeof(payload));
+        sendto(fd, pdu.serializePdu(), pdu.getPduSize(), 0, (sockaddr *) &driver, sizeof(driver));
+    }
+
+    /**
+     * @return false on timeout
+     */
+    bool receive() {
+        uint8_t buffer[1024];
+        return recv(fd, buffer, sizeof(buffer), 0) > 0;
+    }
+
+    uint16_t getPort() const {
+        return port;
+    }
+
+private:
+    int fd;
+    uint16_t port;
+    sockaddr_in driver;
+};
+
+/**
+ * Let the driver echo every DAT_input_output PDU to the client and start receiving on a separate thread.
+ */
+static std::thread startEcho(DcpDriver driver, const Client &client) {
+    driver.setLogManager({[](const LogTemplate &, uint8_t *, size_t) {},
+                          [](size_t size) { return new uint8_t[size]; }});
+    driver.setDcpManager({[driver](DcpPdu &pdu) mutable {
+        if (pdu.getTypeId() == DcpPduType::DAT_input_output) {
+            driver.send(pdu);
+        }
+    }, [](const DcpError) {}});
+
+    uint8_t info[6];
+    *((uint16_t *) info) = client.getPort();
+    *((ip_address_t *) (info + 2)) = INADDR_LOOPBACK;
+    driver.setTargetNetworkInformation(BENCHMARK_DATA_ID, info);
+    return std::thread(driver.startReceiving);
+}
+
+static BenchmarkResult runBenchmark(Client &client, size_t count, size_t window) {
+    BenchmarkResult result = {0, 0, 0, 0, 0};
+
+    //wait until the driver is listening
+    const auto deadline = steady_clock::now() + seconds(5);
+    client.send(0);
+    while (!client.receive()) {
+        if (steady_clock::now() > deadline) {
+            return result;
+        }
+        client.send(0);
+    }
+
+    uint16_t seq = 1;
+    size_t sent = 0;
+    size_t inFlight = 0;
+    const auto start = steady_clock::now();
+    while (result.echoed + result.lost < count) {
+        while (inFlight < window && sent < count) {
+            client.send(seq++);
+            sent++;
+            inFlight++;
+        }
+        if (client.receive()) {
+            result.echoed++;
+        } else {
+            result.lost += inFlight;
+            inFlight = 0;
+            continue;
+        }
+        inFlight--;
+    }
+    const double elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+    result.pdusPerSecond = result.echoed / elapsed;
+
+    std::vector<double> latencies;
+    latencies.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto sendTime = steady_clock::now();
+        client.send(seq++);
+        if (client.receive()) {
+            latencies.push_back(duration_cast<duration<double, std::micro>>(steady_clock::now() - sendTime).count());
+        } else {
+            result.lost++;
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    if (!latencies.empty()) {
+        result.p50 = latencies[latencies.size() / 2];
+        result.p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    }
+    return result;
+}
+
+static void print(const char *name, const BenchmarkResult &result) {
+    std::printf("%-12s %12.0f PDU/s   p50 %8.1f us   p99 %8.1f us   lost %zu\n", name, result.pdusPerSecond,
+                result.p50, result.p99, result.lost);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t window = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32;
+    bool echoed = true;
+
+    {
+        //UdpDriver can not be stopped, its receiving thread runs until the process exits
+        UdpDriver *udpDriver = new UdpDriver("127.0.0.1", 18080);
+        Client client(18080);
+        std::thread receiver = startEcho(udpDriver->getDcpDriver(), client);
+        receiver.detach();
+        BenchmarkResult result = runBenchmark(client, count, window);
+        print("asio", result);
+        echoed &= result.echoed > 0;
+    }
+
+#if defined(DCP_UDP_URING)
+    {
+        UdpUringDriver *uringDriver = new UdpUringDriver("127.0.0.1", 18081);
+        Client client(18081);
+        std::thread receiver = startEcho(uringDriver->getDcpDriver(), client);
+        BenchmarkResult result = runBenchmark(client, count, window);
+        print("io_uring", result);
+        echoed &= result.echoed > 0;
+        //stops the receiving thread
+        delete uringDriver;
+        receiver.join();
+    }
+#endif
+
+    return echoed ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+//
+// Checks of UnixDatagramDriver and UnixStreamDriver
+//
+// - Local::toPath maps a port to a socket in the abstract namespace or to a socket file in a directory
+// - the drivers bind their control socket to that path, a stale socket file of a previous run is replaced
+// - PDUs sent by plain unix domain sockets are received. A datagram is one PDU without length indicator,
+//   the stream driver frames PDUs by their length indicator: it reassembles PDUs split over several writes
+//   and splits PDUs coalesced into one write
+//
+// the DEBUG log messages of every PDU would flood the output
+#undef DEBUG
+#define LOGGING
+
+#define ASIO_STANDALONE
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <dcp/driver/ethernet/local/UnixDatagramDriver.hpp>
+#include <dcp/driver/ethernet/local/UnixStreamDriver.hpp>
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (!condition) {
+        failures++;
+        std::printf("Failed: %s\n", what);
+    }
+}
+
+/**
+ * Records the values of the DAT_input_output PDUs passed to the manager
+ */
+struct Recorder {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<uint32_t> values;
+
+    DcpManager getDcpManager() {
+        return {[this](DcpPdu &msg) {
+            if (msg.getTypeId() != DcpPduType::DAT_input_output) {
+                return;
+            }
+            uint32_t value;
+            std::memcpy(&value, static_cast<DcpPduDatInputOutput &>(msg).getPayload(), sizeof(value));
+            std::lock_guard<std::mutex> lock(mtx);
+            values.push_back(value);
+            cv.notify_all();
+        }, [](const DcpError) {}};
+    }
+
+    bool waitFor(size_t count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&] { return values.size() >= count; });
+    }
+};
+
+static std::vector<uint8_t> serialize(uint32_t value) {
+    DcpPduDatInputOutput pdu(0, 1, (uint8_t *) &value, sizeof(value));
+    return std::vector<uint8_t>(pdu.serialize(), pdu.serialize() + pdu.getSerializedSize());
+}
+
+/**
+ * Connect or send to path with a plain socket. A path starting with '\0' is in the abstract namespace,
+ * its length is part of the address.
+ */
+static int openSocket(int type, const std::string &path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.data(), path.size());
+    int fd = socket(AF_UNIX, type, 0);
+    const socklen_t length = (socklen_t) (offsetof(sockaddr_un, sun_path) + path.size());
+    if (fd >= 0 && connect(fd, (sockaddr *) &address, length) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Connect with retries, the driver binds its socket on its own thread
+ */
+static int connectTo(int type, const std::string &path) {
+    for (int i = 0; i < 500; i++) {
+        int fd = openSocket(type, path);
+        if (fd >= 0) {
+            return fd;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+static bool isAbstractSocketBound(const std::string &name) {
+    std::ifstream file("/proc/net/unix");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() >= name.size() + 1 && line.compare(line.size() - name.size() - 1, std::string::npos,
+                                                           "@" + name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void checkPaths() {
+    check(Local::toPath("", 8080) == std::string("\0dcplib_8080", 12),
+          "an empty directory selects the abstract namespace");
+    check(Local::toPath("/run/dcp", 8080) == "/run/dcp/dcplib_8080", "the socket file is placed in the directory");
+    check(Local::toPath("/run/dcp/", 8080) == "/run/dcp/dcplib_8080", "a trailing slash of the directory is ignored");
+    typedef ProtocolTraits<asio::local::datagram_protocol> Traits;
+    check(Traits::to_string(asio::local::datagram_protocol::endpoint(Local::toPath("", 8080))) == "@dcplib_8080",
+          "abstract sockets are printed with a leading @");
+}
+
+static void checkDatagram(const std::string &directory) {
+    const uint16_t abstractPort = (uint16_t) (20000 + getpid() % 20000);
+    const uint16_t filePort = abstractPort + 1;
+    const std::string filePath = Local::toPath(directory, filePort);
+
+    //a stale file of a previous run does not keep the driver from binding
+    std::ofstream(filePath.c_str()) << "stale";
+
+    static Recorder abstractRecorder;
+    static Recorder fileRecorder;
+    UnixDatagramDriver *abstractDriver = new UnixDatagramDriver(abstractPort);
+    UnixDatagramDriver *fileDriver = new UnixDatagramDriver(filePort, directory);
+    abstractDriver->getDcpDriver().setDcpManager(abstractRecorder.getDcpManager());
+    fileDriver->getDcpDriver().setDcpManager(fileRecorder.getDcpManager());
+    //the io_service runs until the process exits
+    std::thread([abstractDriver] { abstractDriver->getDcpDriver().startReceiving(); }).detach();
+    std::thread([fileDriver] { fileDriver->getDcpDriver().startReceiving(); }).detach();
+
+    int abstractSocket = connectTo(SOCK_DGRAM, Local::toPath("", abstractPort));
+    int fileSocket = connectTo(SOCK_DGRAM, filePath);
+    check(abstractSocket >= 0, "the datagram driver binds its control socket in the abstract namespace");
+    check(fileSocket >= 0, "the datagram driver binds its control socket to a file in the directory");
+    if (abstractSocket < 0 || fileSocket < 0) {
+        return;
+    }
+    check(isAbstractSocketBound("dcplib_" + std::to_string(abstractPort)),
+          "the abstract socket is listed as @dcplib_<port>");
+    check(access(Local::toPath(directory, abstractPort).c_str(), F_OK) != 0, "an abstract socket creates no file");
+    struct stat st;
+    check(stat(filePath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode), "the stale file is replaced by the socket");
+
+    //a datagram carries the PDU without length indicator
+    for (uint32_t i = 0; i < 10; i++) {
+        std::vector<uint8_t> pdu = serialize(i);
+        const size_t size = pdu.size() - PDU_LENGTH_INDICATOR_SIZE;
+        check(::send(abstractSocket, pdu.data() + PDU_LENGTH_INDICATOR_SIZE, size, 0) == (ssize_t) size,
+              "send to the abstract socket");
+        check(::send(fileSocket, pdu.data() + PDU_LENGTH_INDICATOR_SIZE, size, 0) == (ssize_t) size,
+              "send to the socket file");
+    }
+    if (!abstractRecorder.waitFor(10) || !fileRecorder.waitFor(10)) {
+        check(false, "every datagram is received");
+        return;
+    }
+    bool inOrder = true;
+    for (uint32_t i = 0; i < 10; i++) {
+        inOrder = inOrder && abstractRecorder.values[i] == i && fileRecorder.values[i] == i;
+    }
+    check(inOrder, "datagrams are received in order");
+    close(abstractSocket);
+    close(fileSocket);
+}
+
+static void checkStreamFraming(const std::string &directory) {
+    const uint16_t port = (uint16_t) (20000 + getpid() % 20000 + 2);
+
+    static Recorder recorder;
+    UnixStreamDriver *driver = new UnixStreamDriver(port, directory);
+    driver->getDcpDriver().setDcpManager(recorder.getDcpManager());
+    std::thread([driver] { driver->getDcpDriver().startReceiving(); }).detach();
+
+    int fd = connectTo(SOCK_STREAM, Local::toPath(directory, port));
+    check(fd >= 0, "the stream driver accepts connections on the socket file");
+    if (fd < 0) {
+        return;
+    }
+    auto write = [fd](const uint8_t *data, size_t size) {
+        check(::send(fd, data, size, 0) == (ssize_t) size, "write to the stream socket");
+        //gives the driver the chance to read each part on its own
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    };
+
+    //one byte at a time, the length indicator is split as well
+    std::vector<uint8_t> pdu = serialize(0);
+    for (size_t i = 0; i < pdu.size(); i++) {
+        write(pdu.data() + i, 1);
+    }
+    //three PDUs in one write
+    std::vector<uint8_t> coalesced;
+    for (uint32_t i = 1; i <= 3; i++) {
+        std::vector<uint8_t> next = serialize(i);
+        coalesced.insert(coalesced.end(), next.begin(), next.end());
+    }
+    write(coalesced.data(), coalesced.size());
+    //a PDU split after its length indicator, followed by the start of the next one
+    std::vector<uint8_t> split = serialize(4);
+    std::vector<uint8_t> last = serialize(5);
+    split.insert(split.end(), last.begin(), last.begin() + 2);
+    write(split.data(), PDU_LENGTH_INDICATOR_SIZE);
+    write(split.data() + PDU_LENGTH_INDICATOR_SIZE, split.size() - PDU_LENGTH_INDICATOR_SIZE);
+    write(last.data() + 2, last.size() - 2);
+
+    check(recorder.waitFor(6), "every PDU of the stream is received");
+    //PDUs beyond the expected ones would show up now
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::lock_guard<std::mutex> lock(recorder.mtx);
+    bool framed = recorder.values.size() == 6;
+    for (uint32_t i = 0; framed && i < 6; i++) {
+        framed = recorder.values[i] == i;
+    }
+    check(framed, "the stream is split into the PDUs that were written, in order");
+    close(fd);
+}
+
+int main() {
+    char directoryTemplate[] = "/tmp/dcplib_check_XXXXXX";
+    if (mkdtemp(directoryTemplate) == nullptr) {
+        std::printf("Failed: could not create a directory for the socket files\n");
+        return 1;
+    }
+    const std::string directory = directoryTemplate;
+
+    checkPaths();
+    checkDatagram(directory);
+    checkStreamFraming(directory);
+
+    //the drivers keep running until the process exits, their socket files are removed here
+    for (uint16_t offset = 1; offset <= 2; offset++) {
+        unlink(Local::toPath(directory, (uint16_t) (20000 + getpid() % 20000 + offset)).c_str());
+    }
+    rmdir(directory.c_str());
+    std::printf("unix domain driver checks done, %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
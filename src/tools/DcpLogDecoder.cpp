@@ -0,0 +1,33 @@
+//
+// Renders files written by BinaryFileLog as text, in the format of OstreamLog
+//
+#include <iostream>
+#include <stdexcept>
+
+#include <dcp/helper/Helper.hpp>
+#include <dcp/helper/LogHelper.hpp>
+#include <dcp/log/BinaryLogReader.hpp>
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.dcplog>..." << std::endl;
+        std::cerr << "Files are decoded in the given order." << std::endl;
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    for (int i = 1; i < argc; i++) {
+        try {
+            reader.read(argv[i], [](LogEntry &log) {
+                std::cout << convertUnixTimestamp(log.getTime()) << " \t "
+                          << to_string(log.getLevel()) << " \t\t "
+                          << log.getMsg() << '\n';
+            });
+        } catch (const std::exception &e) {
+            std::cout.flush();
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}